@@ -0,0 +1,95 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "byteOrder.h"
+#include <string.h>
+
+int
+hostIsLittleEndian(void)
+{
+	const uint16_t value = 1;
+	uint8_t        firstByte;
+
+	memcpy(&firstByte, &value, 1);
+
+	return firstByte == 1;
+}
+
+uint32_t
+loadLittleEndian32(const uint8_t * const bytes)
+{
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) |
+	       ((uint32_t)bytes[3] << 24);
+}
+
+uint64_t
+loadLittleEndian64(const uint8_t * const bytes)
+{
+	return (uint64_t)loadLittleEndian32(bytes) |
+	       ((uint64_t)loadLittleEndian32(bytes + 4) << 32);
+}
+
+void
+storeLittleEndian32(uint8_t * const bytes, const uint32_t value)
+{
+	for (size_t i = 0; i < 4; i++)
+	{
+		bytes[i] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+void
+storeLittleEndian64(uint8_t * const bytes, const uint64_t value)
+{
+	storeLittleEndian32(bytes, (uint32_t)value);
+	storeLittleEndian32(bytes + 4, (uint32_t)(value >> 32));
+}
+
+void
+copyLittleEndianFloats(float * const destination, const uint8_t * const source, const size_t N)
+{
+	if (hostIsLittleEndian())
+	{
+		memcpy(destination, source, N * sizeof(float));
+		return;
+	}
+
+	for (size_t i = 0; i < N; i++)
+	{
+		const uint32_t bits = loadLittleEndian32(source + 4 * i);
+
+		memcpy(&destination[i], &bits, sizeof(float));
+	}
+}
+
+float
+loadLittleEndianFloat(const uint8_t * const bytes)
+{
+	const uint32_t bits = loadLittleEndian32(bytes);
+	float          value;
+
+	memcpy(&value, &bits, sizeof(value));
+
+	return value;
+}
@@ -0,0 +1,76 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ *	@brief Check whether the host stores multi-byte values little endian.
+ *
+ *	@return int : 1 if little endian, else 0
+ */
+int
+hostIsLittleEndian(void);
+
+/**
+ *	@brief Load an unsigned 32-bit little endian value from unaligned bytes.
+ */
+uint32_t
+loadLittleEndian32(const uint8_t * const bytes);
+
+/**
+ *	@brief Load an unsigned 64-bit little endian value from unaligned bytes.
+ */
+uint64_t
+loadLittleEndian64(const uint8_t * const bytes);
+
+/**
+ *	@brief Load a little endian IEEE 754 float from unaligned bytes.
+ */
+float
+loadLittleEndianFloat(const uint8_t * const bytes);
+
+/**
+ *	@brief Store an unsigned 32-bit value as little endian bytes.
+ */
+void
+storeLittleEndian32(uint8_t * const bytes, const uint32_t value);
+
+/**
+ *	@brief Store an unsigned 64-bit value as little endian bytes.
+ */
+void
+storeLittleEndian64(uint8_t * const bytes, const uint64_t value);
+
+/**
+ *	@brief Copy little endian float32 values into host floats.
+ *
+ *	@param destination : Pointer to N host floats.
+ *	@param source      : Pointer to 4N bytes of little endian float32 values.
+ *	@param N           : Number of values.
+ */
+void
+copyLittleEndianFloats(float * const destination, const uint8_t * const source, const size_t N);
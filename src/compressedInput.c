@@ -0,0 +1,613 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "compressedInput.h"
+#include "csvParser.h"
+#include "sampleFile.h"
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+typedef enum
+{
+	kDecompressionBlockSize = 1 << 20,
+	kDecompressionBlockCount = 4,
+} CompressedInputConstants;
+
+static const uint8_t kGzipMagic[] = {0x1F, 0x8B};
+static const uint8_t kZstdMagic[] = {0x28, 0xB5, 0x2F, 0xFD};
+
+/**
+ *	@brief Streaming decoder state for any supported compression format.
+ *
+ */
+typedef struct Decoder
+{
+	CompressionType type;
+	int             isFinished;
+#ifdef HAVE_ZLIB
+	z_stream      zlibStream;
+	/*
+	 *	Compressed bytes not yet handed to zlib, whose input count is only 32 bits wide
+	 */
+	const Bytef * zlibInput;
+	size_t        zlibInputRemaining;
+#endif
+#ifdef HAVE_ZSTD
+	ZSTD_DStream * zstdStream;
+	ZSTD_inBuffer  zstdInput;
+#endif
+} Decoder;
+
+/**
+ *	@brief Fixed pool of blocks handed from the decompression thread to the parser.
+ *
+ */
+typedef struct BlockQueue
+{
+	char *          blocks[kDecompressionBlockCount];
+	size_t          blockSizes[kDecompressionBlockCount];
+	size_t          head;
+	size_t          count;
+	int             isDone;
+	int             hasError;
+	int             isCancelled;
+	Decoder *       decoder;
+	pthread_mutex_t mutex;
+	pthread_cond_t  blockFilled;
+	pthread_cond_t  blockEmptied;
+} BlockQueue;
+
+#ifdef HAVE_ZLIB
+/**
+ *	@brief Hand zlib the next chunk of compressed input once it has consumed the last one.
+ */
+static void
+refillGzipInput(Decoder * const decoder)
+{
+	if (decoder->zlibStream.avail_in == 0 && decoder->zlibInputRemaining > 0)
+	{
+		const size_t chunk = decoder->zlibInputRemaining < UINT_MAX
+					     ? decoder->zlibInputRemaining
+					     : UINT_MAX;
+
+		decoder->zlibStream.next_in = (Bytef *)decoder->zlibInput;
+		decoder->zlibStream.avail_in = (uInt)chunk;
+		decoder->zlibInput += chunk;
+		decoder->zlibInputRemaining -= chunk;
+	}
+}
+#endif
+
+static int
+decoderInitialise(
+	Decoder * const          decoder,
+	const MappedFile * const file,
+	const CompressionType    type)
+{
+	memset(decoder, 0, sizeof(*decoder));
+	decoder->type = type;
+
+	switch (type)
+	{
+	case kCompressionGzip:
+#ifdef HAVE_ZLIB
+		decoder->zlibInput = (const Bytef *)file->data;
+		decoder->zlibInputRemaining = file->size;
+		refillGzipInput(decoder);
+
+		/*
+		 *	Window bits of 15 + 32 accept gzip (and zlib) headers.
+		 */
+		if (inflateInit2(&decoder->zlibStream, 15 + 32) != Z_OK)
+		{
+			printf("Error: could not initialise gzip decompression\n");
+			return 1;
+		}
+		return 0;
+#else
+		printf("Error: gzip input is not supported by this build (rebuild with HAVE_ZLIB "
+		       "defined and link with -lz)\n");
+		return 1;
+#endif
+	case kCompressionZstd:
+#ifdef HAVE_ZSTD
+		decoder->zstdStream = ZSTD_createDStream();
+		if (decoder->zstdStream == NULL)
+		{
+			printf("Error: could not initialise zstd decompression\n");
+			return 1;
+		}
+		ZSTD_initDStream(decoder->zstdStream);
+		decoder->zstdInput.src = file->data;
+		decoder->zstdInput.size = file->size;
+		decoder->zstdInput.pos = 0;
+		return 0;
+#else
+		printf("Error: zstd input is not supported by this build (rebuild with HAVE_ZSTD "
+		       "defined and link with -lzstd)\n");
+		return 1;
+#endif
+	case kCompressionNone:
+	default:
+		(void)file;
+		return 1;
+	}
+}
+
+/**
+ *	@brief Decompress up to capacity bytes.
+ *
+ *	@param decoder  : Pointer to decoder.
+ *	@param output   : Pointer to output block.
+ *	@param capacity : Size of output block.
+ *	@param produced : Pointer to number of bytes produced. At the end of the stream this is 0
+ *	and decoder->isFinished is set.
+ *	@return int     : 0 if success, 1 if the compressed data is corrupt
+ */
+static int
+decoderRead(
+	Decoder * const decoder,
+	char * const    output,
+	const size_t    capacity,
+	size_t * const  produced)
+{
+	*produced = 0;
+
+	if (decoder->isFinished)
+	{
+		return 0;
+	}
+
+	switch (decoder->type)
+	{
+#ifdef HAVE_ZLIB
+	case kCompressionGzip:
+		decoder->zlibStream.next_out = (Bytef *)output;
+		decoder->zlibStream.avail_out = (uInt)capacity;
+
+		while (decoder->zlibStream.avail_out > 0)
+		{
+			int status;
+
+			refillGzipInput(decoder);
+			status = inflate(&decoder->zlibStream, Z_NO_FLUSH);
+
+			if (status == Z_STREAM_END)
+			{
+				/*
+				 *	Continue with the next member of a multi-member gzip file.
+				 */
+				refillGzipInput(decoder);
+				if (decoder->zlibStream.avail_in == 0 ||
+				    inflateReset(&decoder->zlibStream) != Z_OK)
+				{
+					decoder->isFinished = 1;
+					break;
+				}
+			}
+			else if (status == Z_BUF_ERROR && decoder->zlibStream.avail_in == 0)
+			{
+				printf("Error: gzip input is truncated\n");
+				return 1;
+			}
+			else if (status != Z_OK)
+			{
+				printf("Error: gzip input is corrupt\n");
+				return 1;
+			}
+		}
+
+		*produced = capacity - decoder->zlibStream.avail_out;
+		return 0;
+#endif
+#ifdef HAVE_ZSTD
+	case kCompressionZstd:
+	{
+		ZSTD_outBuffer zstdOutput = {
+			.dst = output,
+			.size = capacity,
+			.pos = 0,
+		};
+
+		while (zstdOutput.pos < zstdOutput.size)
+		{
+			const size_t status = ZSTD_decompressStream(
+				decoder->zstdStream,
+				&zstdOutput,
+				&decoder->zstdInput);
+
+			if (ZSTD_isError(status))
+			{
+				printf("Error: zstd input is corrupt (%s)\n",
+				       ZSTD_getErrorName(status));
+				return 1;
+			}
+
+			if (decoder->zstdInput.pos == decoder->zstdInput.size &&
+			    zstdOutput.pos < zstdOutput.size)
+			{
+				if (status != 0)
+				{
+					printf("Error: zstd input is truncated\n");
+					return 1;
+				}
+				decoder->isFinished = 1;
+				break;
+			}
+		}
+
+		*produced = zstdOutput.pos;
+		return 0;
+	}
+#endif
+	default:
+		(void)output;
+		(void)capacity;
+		return 1;
+	}
+}
+
+static void
+decoderRelease(Decoder * const decoder)
+{
+	switch (decoder->type)
+	{
+#ifdef HAVE_ZLIB
+	case kCompressionGzip:
+		inflateEnd(&decoder->zlibStream);
+		break;
+#endif
+#ifdef HAVE_ZSTD
+	case kCompressionZstd:
+		ZSTD_freeDStream(decoder->zstdStream);
+		break;
+#endif
+	default:
+		break;
+	}
+}
+
+/**
+ *	@brief Decompression thread: fill free blocks until the stream ends.
+ */
+static void *
+decompressBlocks(void * argument)
+{
+	BlockQueue * const queue = (BlockQueue *)argument;
+
+	for (;;)
+	{
+		size_t slot;
+		size_t produced;
+		int    hasError;
+
+		pthread_mutex_lock(&queue->mutex);
+		while (queue->count == kDecompressionBlockCount && !queue->isCancelled)
+		{
+			pthread_cond_wait(&queue->blockEmptied, &queue->mutex);
+		}
+		if (queue->isCancelled)
+		{
+			pthread_mutex_unlock(&queue->mutex);
+			break;
+		}
+		slot = (queue->head + queue->count) % kDecompressionBlockCount;
+		pthread_mutex_unlock(&queue->mutex);
+
+		/*
+		 *	The slot is owned by this thread until it is published.
+		 */
+		hasError = decoderRead(
+			queue->decoder,
+			queue->blocks[slot],
+			kDecompressionBlockSize,
+			&produced);
+
+		pthread_mutex_lock(&queue->mutex);
+		if (hasError)
+		{
+			queue->hasError = 1;
+			queue->isDone = 1;
+		}
+		else if (produced > 0)
+		{
+			queue->blockSizes[slot] = produced;
+			queue->count++;
+		}
+
+		if (queue->decoder->isFinished)
+		{
+			queue->isDone = 1;
+		}
+		pthread_cond_signal(&queue->blockFilled);
+		pthread_mutex_unlock(&queue->mutex);
+
+		if (hasError || queue->decoder->isFinished)
+		{
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ *	@brief Append bytes to a growing heap allocation held in a MappedFile.
+ *
+ *	@return int : 0 if success, 1 if out of memory
+ */
+static int
+appendToMemory(
+	MappedFile * const memory,
+	size_t * const     capacity,
+	const char * const data,
+	const size_t       size)
+{
+	if (memory->size + size > *capacity)
+	{
+		const size_t newCapacity = (memory->size + size) * 2;
+		char * const newData = (char *)realloc((void *)memory->data, newCapacity);
+
+		if (newData == NULL)
+		{
+			return 1;
+		}
+
+		memory->data = newData;
+		*capacity = newCapacity;
+	}
+
+	memcpy((char *)memory->data + memory->size, data, size);
+	memory->size += size;
+
+	return 0;
+}
+
+CompressionType
+detectCompression(const MappedFile * const file)
+{
+	if (file->size >= sizeof(kGzipMagic) &&
+	    memcmp(file->data, kGzipMagic, sizeof(kGzipMagic)) == 0)
+	{
+		return kCompressionGzip;
+	}
+
+	if (file->size >= sizeof(kZstdMagic) &&
+	    memcmp(file->data, kZstdMagic, sizeof(kZstdMagic)) == 0)
+	{
+		return kCompressionZstd;
+	}
+
+	return kCompressionNone;
+}
+
+int
+decompressToMemory(
+	const MappedFile * const file,
+	const CompressionType    compression,
+	MappedFile * const       decompressed)
+{
+	Decoder decoder;
+	size_t  capacity = 0;
+	int     returnValue = 0;
+	char *  block = (char *)malloc(kDecompressionBlockSize);
+
+	decompressed->data = NULL;
+	decompressed->size = 0;
+	decompressed->isMapped = 0;
+
+	if (block == NULL)
+	{
+		return 1;
+	}
+
+	if (decoderInitialise(&decoder, file, compression))
+	{
+		free(block);
+		return 1;
+	}
+
+	while (!decoder.isFinished)
+	{
+		size_t produced;
+
+		if (decoderRead(&decoder, block, kDecompressionBlockSize, &produced) ||
+		    appendToMemory(decompressed, &capacity, block, produced))
+		{
+			returnValue = 1;
+			break;
+		}
+	}
+
+	decoderRelease(&decoder);
+	free(block);
+
+	if (returnValue != 0)
+	{
+		unmapFile(decompressed);
+	}
+
+	return returnValue;
+}
+
+int
+readCompressedSamples(
+	const MappedFile * const   file,
+	const CompressionType      compression,
+	const CountScaling * const scaling,
+	Buffer * const             buf,
+	InputFileInfo * const      info)
+{
+	Decoder         decoder;
+	BlockQueue      queue;
+	CSVStreamParser parser;
+	pthread_t       thread;
+	MappedFile      sampleFile = {
+		     .data = NULL,
+		     .size = 0,
+		     .isMapped = 0,
+	};
+	size_t sampleFileCapacity = 0;
+	int    isFirstBlock = 1;
+	int    isSampleFileData = 0;
+	int    returnValue = 0;
+
+	buf->heapPointer = NULL;
+	buf->size = 0;
+
+	if (decoderInitialise(&decoder, file, compression))
+	{
+		return 1;
+	}
+
+	memset(&queue, 0, sizeof(queue));
+	queue.decoder = &decoder;
+	for (size_t i = 0; i < kDecompressionBlockCount; i++)
+	{
+		queue.blocks[i] = (char *)malloc(kDecompressionBlockSize);
+		if (queue.blocks[i] == NULL)
+		{
+			returnValue = 1;
+		}
+	}
+
+	pthread_mutex_init(&queue.mutex, NULL);
+	pthread_cond_init(&queue.blockFilled, NULL);
+	pthread_cond_init(&queue.blockEmptied, NULL);
+	csvStreamParserInitialise(&parser);
+
+	if (returnValue != 0 || pthread_create(&thread, NULL, decompressBlocks, &queue) != 0)
+	{
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	/*
+	 *	Parse blocks as the decompression thread produces them.
+	 */
+	for (;;)
+	{
+		char * block;
+		size_t blockSize;
+		int    consumeError;
+
+		pthread_mutex_lock(&queue.mutex);
+		while (queue.count == 0 && !queue.isDone)
+		{
+			pthread_cond_wait(&queue.blockFilled, &queue.mutex);
+		}
+		if (queue.count == 0)
+		{
+			pthread_mutex_unlock(&queue.mutex);
+			break;
+		}
+		block = queue.blocks[queue.head];
+		blockSize = queue.blockSizes[queue.head];
+		pthread_mutex_unlock(&queue.mutex);
+
+		if (isFirstBlock)
+		{
+			const MappedFile firstBlock = {
+				.data = block,
+				.size = blockSize,
+				.isMapped = 0,
+			};
+
+			isSampleFileData = isSampleFile(&firstBlock);
+			isFirstBlock = 0;
+		}
+
+		consumeError =
+			isSampleFileData
+				? appendToMemory(&sampleFile, &sampleFileCapacity, block, blockSize)
+				: csvStreamParserFeed(&parser, block, blockSize);
+
+		pthread_mutex_lock(&queue.mutex);
+		queue.head = (queue.head + 1) % kDecompressionBlockCount;
+		queue.count--;
+		if (consumeError)
+		{
+			queue.isCancelled = 1;
+		}
+		pthread_cond_signal(&queue.blockEmptied);
+		pthread_mutex_unlock(&queue.mutex);
+
+		if (consumeError)
+		{
+			printf("Error: The program ran out of heap memory. Try reducing the amount "
+			       "of input data, or increasing the amount of available memory by "
+			       "selecting a different core.\n");
+			returnValue = 1;
+			break;
+		}
+	}
+
+	pthread_join(thread, NULL);
+
+	if (queue.hasError)
+	{
+		returnValue = 1;
+	}
+
+	if (returnValue == 0 && isSampleFileData)
+	{
+		returnValue = readSampleFileChannel(&sampleFile, 0, scaling, buf, info);
+	}
+	else if (returnValue == 0)
+	{
+		returnValue = csvStreamParserFinish(&parser, buf);
+	}
+
+RETURN:
+	/*
+	 *	Release whatever the parser still holds (nothing if it has already been finished).
+	 */
+	{
+		Buffer discarded;
+
+		csvStreamParserFinish(&parser, &discarded);
+		free(discarded.heapPointer);
+	}
+	unmapFile(&sampleFile);
+	for (size_t i = 0; i < kDecompressionBlockCount; i++)
+	{
+		free(queue.blocks[i]);
+	}
+	pthread_mutex_destroy(&queue.mutex);
+	pthread_cond_destroy(&queue.blockFilled);
+	pthread_cond_destroy(&queue.blockEmptied);
+	decoderRelease(&decoder);
+
+	return returnValue;
+}
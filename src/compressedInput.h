@@ -0,0 +1,87 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "fileMapping.h"
+#include "utils.h"
+
+/*
+ *	gzip support requires building with HAVE_ZLIB defined and linking with -lz. zstd support
+ *	requires building with HAVE_ZSTD defined and linking with -lzstd. Compressed inputs are
+ *	always recognised, and reported as unsupported when the corresponding library is absent.
+ */
+
+typedef enum
+{
+	kCompressionNone,
+	kCompressionGzip,
+	kCompressionZstd,
+} CompressionType;
+
+/**
+ *	@brief Identify the compression format of a mapped file from its magic number.
+ *
+ *	@param file             : Pointer to mapped file.
+ *	@return CompressionType : Compression format, or kCompressionNone.
+ */
+CompressionType
+detectCompression(const MappedFile * const file);
+
+/**
+ *	@brief Decompress a mapped file and parse it as a single column CSV file.
+ *	@note Decompression runs on a separate thread and hands blocks over to the parser as they
+ *	are produced, so decompression and parsing overlap. A compressed binary sample file is
+ *	decompressed into memory and its first channel read.
+ *
+ *	@param file        : Pointer to mapped compressed file.
+ *	@param compression : Compression format.
+ *	@param scaling     : Pointer to count scaling overrides for binary sample files (may be
+ *	NULL).
+ *	@param buf         : Pointer to Buffer to store the values.
+ *	@param info        : Pointer to location to store file metadata (may be NULL).
+ *	@return int        : 0 if success, 1 if error encountered
+ */
+int
+readCompressedSamples(
+	const MappedFile * const   file,
+	const CompressionType      compression,
+	const CountScaling * const scaling,
+	Buffer * const             buf,
+	InputFileInfo * const      info);
+
+/**
+ *	@brief Decompress a mapped file into memory.
+ *
+ *	@param file         : Pointer to mapped compressed file.
+ *	@param compression  : Compression format.
+ *	@param decompressed : Pointer to MappedFile to store the decompressed contents (release
+ *	with unmapFile()).
+ *	@return int         : 0 if success, 1 if error encountered
+ */
+int
+decompressToMemory(
+	const MappedFile * const file,
+	const CompressionType    compression,
+	MappedFile * const       decompressed);
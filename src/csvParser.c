@@ -0,0 +1,1149 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "csvParser.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+typedef enum
+{
+	kMaximumExactPowerOfTen = 22,
+	kMaximumExponentMagnitude = 100000,
+	kFallbackTokenLength = 128,
+	kEstimatedBytesPerCSVValue = 16,
+	kMinimumCSVBufferCapacity = 64,
+	kMaximumParseThreads = 64,
+	kMinimumParseChunkSize = 1 << 22,
+} CSVParserConstants;
+
+typedef enum
+{
+	kParseStatusComplete,
+	kParseStatusStopped,
+	kParseStatusFull,
+} ParseStatus;
+
+typedef enum
+{
+	kParallelParseSuccess,
+	kParallelParseOutOfMemory,
+	kParallelParseFallback,
+} ParallelParseResult;
+
+/**
+ *	@brief A newline aligned section of the input, parsed by one thread.
+ *
+ */
+typedef struct ParseChunk
+{
+	const char * start;
+	const char * end;
+	size_t       valueCount;
+	size_t       offset;
+	float *      output;
+	size_t       parsedCount;
+	ParseStatus  status;
+} ParseChunk;
+
+/*
+ *	Mantissa values below these limits can accept another 8 digits (resp. 1 digit) without
+ *	overflowing a uint64_t.
+ */
+static const uint64_t kMaximumMantissaForEightDigits = 100000000000ULL;
+static const uint64_t kMaximumMantissaForOneDigit = 1000000000000000000ULL;
+
+/*
+ *	Mantissa values up to this limit convert to double exactly.
+ */
+static const uint64_t kMaximumExactMantissa = 1ULL << 53;
+
+static const double kPowersOfTen[kMaximumExactPowerOfTen + 1] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static int
+isDigit(const char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static int
+isWhitespace(const char c)
+{
+	return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+/**
+ *	@brief Check whether 8 characters loaded as a little endian word are all decimal digits.
+ */
+static int
+isEightDigits(const uint64_t word)
+{
+	return ((word & 0xF0F0F0F0F0F0F0F0ULL) |
+		(((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+	       0x3333333333333333ULL;
+}
+
+/**
+ *	@brief Convert 8 decimal digits loaded as a little endian word to their integer value.
+ */
+static uint32_t
+parseEightDigits(uint64_t word)
+{
+	const uint64_t mask = 0x000000FF000000FFULL;
+
+	word -= 0x3030303030303030ULL;
+	word = (word * 10) + (word >> 8);
+	word = (((word & mask) * (100 + (1000000ULL << 32))) +
+		(((word >> 16) & mask) * (1 + (10000ULL << 32)))) >>
+	       32;
+
+	return (uint32_t)word;
+}
+
+/**
+ *	@brief Accumulate a run of decimal digits into a mantissa, eight at a time where possible.
+ *	@note Digits that do not fit in the mantissa are skipped and counted as dropped.
+ *
+ *	@param p              : Pointer to the current position, advanced past the digits.
+ *	@param end            : Pointer to one past the last character available.
+ *	@param mantissa       : Pointer to the mantissa to accumulate into.
+ *	@param acceptedDigits : Pointer to count of digits added to the mantissa.
+ *	@param droppedDigits  : Pointer to count of digits that did not fit in the mantissa.
+ *	@return int           : 1 if at least one digit was found, else 0
+ */
+static int
+accumulateDigits(
+	const char ** const p,
+	const char * const  end,
+	uint64_t * const    mantissa,
+	int * const         acceptedDigits,
+	int * const         droppedDigits)
+{
+	const char * position = *p;
+
+	while (end - position >= 8 && *mantissa < kMaximumMantissaForEightDigits)
+	{
+		uint64_t word;
+
+		memcpy(&word, position, sizeof(word));
+		if (!isEightDigits(word))
+		{
+			break;
+		}
+
+		*mantissa = *mantissa * 100000000ULL + parseEightDigits(word);
+		*acceptedDigits += 8;
+		position += 8;
+	}
+
+	for (; position < end && isDigit(*position); position++)
+	{
+		if (*mantissa < kMaximumMantissaForOneDigit)
+		{
+			*mantissa = *mantissa * 10 + (*position - '0');
+			(*acceptedDigits)++;
+		}
+		else
+		{
+			(*droppedDigits)++;
+		}
+	}
+
+	if (position == *p)
+	{
+		return 0;
+	}
+
+	*p = position;
+
+	return 1;
+}
+
+/**
+ *	@brief Parse a value with strtod() from a NUL terminated copy of the input.
+ */
+static size_t
+parseWithLibrary(const char * const start, const char * const end, double * const value)
+{
+	char         token[kFallbackTokenLength];
+	char *       tokenEnd;
+	const size_t length = (size_t)(end - start) < sizeof(token) - 1 ? (size_t)(end - start)
+									: sizeof(token) - 1;
+
+	memcpy(token, start, length);
+	token[length] = '\0';
+
+	*value = strtod(token, &tokenEnd);
+
+	return tokenEnd - token;
+}
+
+/**
+ *	@brief Parse a plain decimal value without going through the C library.
+ *	@return size_t : Number of characters consumed, or 0 if the value needs the C library.
+ */
+static size_t
+parseDecimal(const char * const start, const char * const end, double * const value)
+{
+	const char * p = start;
+	uint64_t     mantissa = 0;
+	int          acceptedDigits = 0;
+	int          droppedDigits = 0;
+	int          isTruncated;
+	int          exponent;
+	int          hasDigits;
+	int          isNegative = 0;
+	double       result;
+
+	if (p < end && (*p == '+' || *p == '-'))
+	{
+		isNegative = (*p == '-');
+		p++;
+	}
+
+	hasDigits = accumulateDigits(&p, end, &mantissa, &acceptedDigits, &droppedDigits);
+	exponent = droppedDigits;
+	isTruncated = (droppedDigits > 0);
+
+	if (p < end && *p == '.')
+	{
+		acceptedDigits = 0;
+		droppedDigits = 0;
+		p++;
+		hasDigits |= accumulateDigits(&p, end, &mantissa, &acceptedDigits, &droppedDigits);
+		exponent -= acceptedDigits;
+		isTruncated |= (droppedDigits > 0);
+	}
+
+	if (!hasDigits || (p < end && (*p == 'x' || *p == 'X')))
+	{
+		/*
+		 *	Infinity, NaN, hexadecimal or not a number at all.
+		 */
+		return 0;
+	}
+
+	if (p < end && (*p == 'e' || *p == 'E'))
+	{
+		const char * exponentStart = p + 1;
+		int          exponentIsNegative = 0;
+		int          exponentValue = 0;
+
+		if (exponentStart < end && (*exponentStart == '+' || *exponentStart == '-'))
+		{
+			exponentIsNegative = (*exponentStart == '-');
+			exponentStart++;
+		}
+
+		if (exponentStart < end && isDigit(*exponentStart))
+		{
+			for (p = exponentStart; p < end && isDigit(*p); p++)
+			{
+				if (exponentValue < kMaximumExponentMagnitude)
+				{
+					exponentValue = exponentValue * 10 + (*p - '0');
+				}
+			}
+
+			exponent += exponentIsNegative ? -exponentValue : exponentValue;
+		}
+	}
+
+	if (mantissa == 0)
+	{
+		result = 0;
+	}
+	else if (mantissa <= kMaximumExactMantissa && !isTruncated &&
+		 exponent >= -kMaximumExactPowerOfTen && exponent <= kMaximumExactPowerOfTen)
+	{
+		/*
+		 *	The mantissa and the power of ten are both exact doubles, so this is a
+		 *	single correctly rounded double operation. Longer mantissas would be rounded
+		 *	twice.
+		 */
+		result = (double)mantissa;
+		result = exponent < 0 ? result / kPowersOfTen[-exponent]
+				      : result * kPowersOfTen[exponent];
+	}
+	else
+	{
+		return 0;
+	}
+
+	*value = isNegative ? -result : result;
+
+	return p - start;
+}
+
+size_t
+parseDouble(const char * const start, const char * const end, double * const value)
+{
+	const size_t consumed = parseDecimal(start, end, value);
+
+	return consumed > 0 ? consumed : parseWithLibrary(start, end, value);
+}
+
+size_t
+parseFloat(const char * const start, const char * const end, float * const value)
+{
+	double       result;
+	const size_t consumed = parseDouble(start, end, &result);
+
+	if (consumed > 0)
+	{
+		*value = (float)result;
+	}
+
+	return consumed;
+}
+
+/**
+ *	@brief Parse values from a character range into a fixed capacity output array.
+ *
+ *	@param p        : Pointer to the current position, advanced past the parsed values.
+ *	@param end      : Pointer to one past the last character available.
+ *	@param output   : Pointer to array to store the parsed values.
+ *	@param capacity : Number of elements available in the output array.
+ *	@param count    : Pointer to the number of values parsed (updated).
+ *	@return ParseStatus : Why parsing finished.
+ */
+static ParseStatus
+parseFloatRange(
+	const char ** const p,
+	const char * const  end,
+	float * const       output,
+	const size_t        capacity,
+	size_t * const      count)
+{
+	const char * position = *p;
+	ParseStatus  status = kParseStatusComplete;
+
+	for (;;)
+	{
+		float  value;
+		size_t consumed;
+
+		while (position < end && isWhitespace(*position))
+		{
+			position++;
+		}
+
+		if (position == end)
+		{
+			break;
+		}
+
+		if (*count == capacity)
+		{
+			status = kParseStatusFull;
+			break;
+		}
+
+		consumed = parseFloat(position, end, &value);
+		if (consumed == 0)
+		{
+			status = kParseStatusStopped;
+			break;
+		}
+
+		position += consumed;
+		if (position < end && *position == ',')
+		{
+			position++;
+		}
+
+		output[(*count)++] = value;
+	}
+
+	*p = position;
+
+	return status;
+}
+
+/**
+ *	@brief Count the values in a chunk, as the number of runs of characters that are neither
+ *	whitespace nor commas.
+ *	@note This matches the number of values parsed from well formed input. Chunks where it
+ *	does not are detected after parsing.
+ */
+static void *
+countChunkValues(void * argument)
+{
+	ParseChunk * const chunk = (ParseChunk *)argument;
+	size_t             count = 0;
+	int                previousIsSeparator = 1;
+
+	for (const char * p = chunk->start; p < chunk->end; p++)
+	{
+		const int isSeparator = isWhitespace(*p) | (*p == ',');
+
+		count += previousIsSeparator & !isSeparator;
+		previousIsSeparator = isSeparator;
+	}
+
+	chunk->valueCount = count;
+
+	return NULL;
+}
+
+/**
+ *	@brief Parse the values in a chunk into its slot of the output buffer.
+ */
+static void *
+parseChunkValues(void * argument)
+{
+	ParseChunk * const chunk = (ParseChunk *)argument;
+	const char *       p = chunk->start;
+
+	chunk->parsedCount = 0;
+	chunk->status =
+		parseFloatRange(&p, chunk->end, chunk->output, chunk->valueCount, &chunk->parsedCount);
+
+	return NULL;
+}
+
+/**
+ *	@brief Run a function on every chunk, one thread per chunk (the first on the calling
+ *	thread).
+ *
+ *	@return int : 0 if success, 1 if a thread could not be created
+ */
+static int
+runOnChunks(ParseChunk * const chunks, const size_t chunkCount, void * (*function)(void *))
+{
+	pthread_t threads[kMaximumParseThreads];
+	size_t    startedThreads = 0;
+	int       returnValue = 0;
+
+	for (size_t i = 1; i < chunkCount; i++)
+	{
+		if (pthread_create(&threads[i], NULL, function, &chunks[i]) != 0)
+		{
+			returnValue = 1;
+			break;
+		}
+		startedThreads = i;
+	}
+
+	function(&chunks[0]);
+
+	for (size_t i = 1; i <= startedThreads; i++)
+	{
+		pthread_join(threads[i], NULL);
+	}
+
+	return returnValue;
+}
+
+/**
+ *	@brief Release the unused tail of a buffer, or the whole buffer if it is empty.
+ */
+static void
+shrinkBufferToFit(Buffer * const buf, const size_t capacity)
+{
+	if (buf->size == 0)
+	{
+		free(buf->heapPointer);
+		buf->heapPointer = NULL;
+	}
+	else if (buf->size < capacity)
+	{
+		float * const newPointer =
+			(float *)reallocarray(buf->heapPointer, buf->size, sizeof(float));
+
+		if (newPointer != NULL)
+		{
+			buf->heapPointer = newPointer;
+		}
+	}
+}
+
+/**
+ *	@brief Parse values serially, growing the buffer geometrically as required.
+ *
+ *	@return int : 0 if success, 1 if out of memory
+ */
+static int
+parseFloatsSerially(const char * const data, const size_t size, Buffer * const buf)
+{
+	const char * p = data;
+	const char * end = data + size;
+	size_t       capacity = size / kEstimatedBytesPerCSVValue + kMinimumCSVBufferCapacity;
+
+	buf->size = 0;
+	buf->heapPointer = (float *)malloc(capacity * sizeof(float));
+
+	if (buf->heapPointer == NULL)
+	{
+		return 1;
+	}
+
+	while (parseFloatRange(&p, end, buf->heapPointer, capacity, &buf->size) ==
+	       kParseStatusFull)
+	{
+		float * const newPointer =
+			(float *)reallocarray(buf->heapPointer, capacity * 2, sizeof(float));
+
+		if (newPointer == NULL)
+		{
+			free(buf->heapPointer);
+			buf->heapPointer = NULL;
+			buf->size = 0;
+			return 1;
+		}
+
+		buf->heapPointer = newPointer;
+		capacity *= 2;
+	}
+
+	shrinkBufferToFit(buf, capacity);
+
+	return 0;
+}
+
+/**
+ *	@brief Parse values in parallel. The data is split into chunks at newline boundaries,
+ *	values in each chunk are counted, and the prefix sum of the counts gives each chunk the
+ *	offset in the output buffer that it parses into.
+ *
+ *	@return ParallelParseResult : Success, out of memory, or a request to parse serially
+ *	(thread creation failed or the input is not in the expected format).
+ */
+static ParallelParseResult
+parseFloatsInParallel(
+	const char * const data,
+	const size_t       size,
+	Buffer * const     buf,
+	size_t             chunkCount)
+{
+	ParseChunk   chunks[kMaximumParseThreads];
+	const char * end = data + size;
+	const char * chunkStart = data;
+	size_t       totalCount = 0;
+	size_t       usedChunks = 0;
+
+	for (size_t i = 0; i < chunkCount && chunkStart < end; i++)
+	{
+		const char * chunkEnd =
+			(i == chunkCount - 1) ? end : data + size / chunkCount * (i + 1);
+
+		if (chunkEnd < chunkStart)
+		{
+			chunkEnd = chunkStart;
+		}
+
+		chunkEnd = (const char *)memchr(chunkEnd, '\n', end - chunkEnd);
+		chunkEnd = (chunkEnd == NULL) ? end : chunkEnd + 1;
+
+		chunks[i].start = chunkStart;
+		chunks[i].end = chunkEnd;
+		chunkStart = chunkEnd;
+		usedChunks++;
+	}
+
+	if (runOnChunks(chunks, usedChunks, countChunkValues))
+	{
+		return kParallelParseFallback;
+	}
+
+	for (size_t i = 0; i < usedChunks; i++)
+	{
+		chunks[i].offset = totalCount;
+		totalCount += chunks[i].valueCount;
+	}
+
+	buf->size = 0;
+	buf->heapPointer = (float *)malloc((totalCount ? totalCount : 1) * sizeof(float));
+	if (buf->heapPointer == NULL)
+	{
+		return kParallelParseOutOfMemory;
+	}
+
+	for (size_t i = 0; i < usedChunks; i++)
+	{
+		chunks[i].output = buf->heapPointer + chunks[i].offset;
+	}
+
+	if (runOnChunks(chunks, usedChunks, parseChunkValues))
+	{
+		free(buf->heapPointer);
+		buf->heapPointer = NULL;
+		return kParallelParseFallback;
+	}
+
+	/*
+	 *	The result runs up to the first chunk that did not parse exactly its counted values.
+	 *	If that chunk stopped at a value that cannot be parsed, a serial parse would stop in
+	 *	the same place. Anything else means the counts were wrong.
+	 */
+	buf->size = totalCount;
+	for (size_t i = 0; i < usedChunks; i++)
+	{
+		if (chunks[i].status == kParseStatusStopped)
+		{
+			buf->size = chunks[i].offset + chunks[i].parsedCount;
+			break;
+		}
+
+		if (chunks[i].status != kParseStatusComplete ||
+		    chunks[i].parsedCount != chunks[i].valueCount)
+		{
+			free(buf->heapPointer);
+			buf->heapPointer = NULL;
+			buf->size = 0;
+			return kParallelParseFallback;
+		}
+	}
+
+	shrinkBufferToFit(buf, totalCount);
+
+	return kParallelParseSuccess;
+}
+
+int
+parseFloatsFromCSV(const char * const data, const size_t size, Buffer * const buf)
+{
+	long   processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t chunkCount = size / kMinimumParseChunkSize;
+
+	if (processorCount < 1)
+	{
+		processorCount = 1;
+	}
+
+	if (chunkCount > (size_t)processorCount)
+	{
+		chunkCount = processorCount;
+	}
+
+	if (chunkCount > kMaximumParseThreads)
+	{
+		chunkCount = kMaximumParseThreads;
+	}
+
+	if (chunkCount > 1)
+	{
+		switch (parseFloatsInParallel(data, size, buf, chunkCount))
+		{
+		case kParallelParseSuccess:
+			return 0;
+		case kParallelParseOutOfMemory:
+			return 1;
+		case kParallelParseFallback:
+			break;
+		}
+	}
+
+	return parseFloatsSerially(data, size, buf);
+}
+
+void
+csvStreamParserInitialise(CSVStreamParser * const parser)
+{
+	memset(parser, 0, sizeof(*parser));
+}
+
+/**
+ *	@brief Parse a block of complete lines into the parser's growing Buffer.
+ *
+ *	@return int : 0 if success, 1 if out of memory
+ */
+static int
+csvStreamParserParseLines(CSVStreamParser * const parser, const char * p, const char * const end)
+{
+	while (!parser->isStopped)
+	{
+		ParseStatus status;
+
+		if (parser->values.size == parser->capacity)
+		{
+			const size_t  newCapacity = parser->capacity ? parser->capacity * 2
+								    : kMinimumCSVBufferCapacity;
+			float * const newPointer = (float *)reallocarray(
+				parser->values.heapPointer,
+				newCapacity,
+				sizeof(float));
+
+			if (newPointer == NULL)
+			{
+				return 1;
+			}
+
+			parser->values.heapPointer = newPointer;
+			parser->capacity = newCapacity;
+		}
+
+		status = parseFloatRange(
+			&p,
+			end,
+			parser->values.heapPointer,
+			parser->capacity,
+			&parser->values.size);
+
+		if (status == kParseStatusComplete)
+		{
+			break;
+		}
+
+		parser->isStopped = (status == kParseStatusStopped);
+	}
+
+	return 0;
+}
+
+/**
+ *	@brief Append characters to the parser's carry buffer.
+ *
+ *	@return int : 0 if success, 1 if out of memory
+ */
+static int
+csvStreamParserCarry(CSVStreamParser * const parser, const char * const data, const size_t size)
+{
+	if (size == 0)
+	{
+		return 0;
+	}
+
+	if (parser->carrySize + size > parser->carryCapacity)
+	{
+		const size_t newCapacity = (parser->carrySize + size) * 2;
+		char * const newCarry = (char *)realloc(parser->carry, newCapacity);
+
+		if (newCarry == NULL)
+		{
+			return 1;
+		}
+
+		parser->carry = newCarry;
+		parser->carryCapacity = newCapacity;
+	}
+
+	memcpy(parser->carry + parser->carrySize, data, size);
+	parser->carrySize += size;
+
+	return 0;
+}
+
+int
+csvStreamParserFeed(CSVStreamParser * const parser, const char * const data, const size_t size)
+{
+	const char * const end = data + size;
+	const char *       firstLineEnd;
+	const char *       lastLineEnd;
+
+	if (parser->isStopped || size == 0)
+	{
+		return 0;
+	}
+
+	firstLineEnd = (const char *)memchr(data, '\n', size);
+	if (firstLineEnd == NULL)
+	{
+		return csvStreamParserCarry(parser, data, size);
+	}
+
+	/*
+	 *	Complete the line carried over from the previous block.
+	 */
+	if (parser->carrySize > 0)
+	{
+		if (csvStreamParserCarry(parser, data, firstLineEnd + 1 - data) ||
+		    csvStreamParserParseLines(parser, parser->carry, parser->carry + parser->carrySize))
+		{
+			return 1;
+		}
+
+		parser->carrySize = 0;
+	}
+	else
+	{
+		firstLineEnd = data - 1;
+	}
+
+	lastLineEnd = firstLineEnd;
+	for (const char * p = end; p > firstLineEnd + 1; p--)
+	{
+		if (p[-1] == '\n')
+		{
+			lastLineEnd = p - 1;
+			break;
+		}
+	}
+
+	if (csvStreamParserParseLines(parser, firstLineEnd + 1, lastLineEnd + 1))
+	{
+		return 1;
+	}
+
+	return csvStreamParserCarry(parser, lastLineEnd + 1, end - (lastLineEnd + 1));
+}
+
+int
+csvStreamParserFinish(CSVStreamParser * const parser, Buffer * const buf)
+{
+	int returnValue = 0;
+
+	if (parser->carrySize > 0 &&
+	    csvStreamParserParseLines(parser, parser->carry, parser->carry + parser->carrySize))
+	{
+		returnValue = 1;
+	}
+
+	*buf = parser->values;
+	if (returnValue != 0)
+	{
+		free(buf->heapPointer);
+		buf->heapPointer = NULL;
+		buf->size = 0;
+	}
+	else
+	{
+		shrinkBufferToFit(buf, parser->capacity);
+	}
+
+	free(parser->carry);
+	memset(parser, 0, sizeof(*parser));
+
+	return returnValue;
+}
+
+/**
+ *	@brief Skip spaces and tabs (but not line breaks).
+ */
+static const char *
+skipBlanks(const char * p, const char * const end)
+{
+	while (p < end && (*p == ' ' || *p == '\t'))
+	{
+		p++;
+	}
+
+	return p;
+}
+
+static const char *
+findLineEnd(const char * const p, const char * const end)
+{
+	const char * const lineEnd = (const char *)memchr(p, '\n', end - p);
+
+	return lineEnd == NULL ? end : lineEnd;
+}
+
+static int
+isBlankLine(const char * p, const char * const lineEnd)
+{
+	while (p < lineEnd && isWhitespace(*p))
+	{
+		p++;
+	}
+
+	return p == lineEnd;
+}
+
+/**
+ *	@brief Check whether a selector is a column index (all decimal digits).
+ */
+static int
+isColumnIndex(const char * const selector)
+{
+	if (*selector == '\0')
+	{
+		return 0;
+	}
+
+	for (const char * p = selector; *p != '\0'; p++)
+	{
+		if (!isDigit(*p))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ *	@brief Find the index of a named column in a header line.
+ *
+ *	@return long : Column index, or -1 if no column has the given name.
+ */
+static long
+findColumnByName(const char * p, const char * const lineEnd, const char * const name)
+{
+	const size_t nameLength = strlen(name);
+
+	for (long column = 0; p <= lineEnd; column++)
+	{
+		const char * fieldEnd = (const char *)memchr(p, ',', lineEnd - p);
+		const char * nameEnd;
+
+		fieldEnd = (fieldEnd == NULL) ? lineEnd : fieldEnd;
+		p = skipBlanks(p, fieldEnd);
+		for (nameEnd = fieldEnd; nameEnd > p && isWhitespace(nameEnd[-1]); nameEnd--)
+		{
+		}
+
+		if ((size_t)(nameEnd - p) == nameLength && strncasecmp(p, name, nameLength) == 0)
+		{
+			return column;
+		}
+
+		p = fieldEnd + 1;
+	}
+
+	return -1;
+}
+
+/**
+ *	@brief Parse the selected fields of one CSV row.
+ *
+ *	@return int : 0 if every selected field held a value, else 1
+ */
+static int
+parseRow(
+	const char *                p,
+	const char * const          lineEnd,
+	const long                  maximumColumn,
+	double * const              rowValues,
+	const unsigned char * const isSelectedColumn)
+{
+	for (long column = 0; column <= maximumColumn; column++)
+	{
+		if (p > lineEnd)
+		{
+			return 1;
+		}
+
+		if (isSelectedColumn[column])
+		{
+			size_t consumed;
+
+			p = skipBlanks(p, lineEnd);
+			consumed = parseDouble(p, lineEnd, &rowValues[column]);
+			if (consumed == 0)
+			{
+				return 1;
+			}
+
+			p = skipBlanks(p + consumed, lineEnd);
+			if (p < lineEnd && *p != ',' && *p != '\r')
+			{
+				return 1;
+			}
+		}
+
+		p = (const char *)memchr(p, ',', lineEnd - p);
+		p = (p == NULL) ? lineEnd + 1 : p + 1;
+	}
+
+	return 0;
+}
+
+int
+parseColumnsFromCSV(
+	const char * const         data,
+	const size_t               size,
+	const char * const * const selectors,
+	const size_t               selectorCount,
+	Buffer * const             columns,
+	double * const             columnSpans)
+{
+	const char *    p = data;
+	const char *    end = data + size;
+	const char *    lineEnd;
+	long *          columnIndices = (long *)calloc(selectorCount, sizeof(long));
+	double *        rowValues = NULL;
+	double *        firstValues = NULL;
+	unsigned char * isSelectedColumn = NULL;
+	long            maximumColumn = -1;
+	size_t          capacity = size / kEstimatedBytesPerCSVValue + kMinimumCSVBufferCapacity;
+	size_t          rowCount = 0;
+	int             hasHeader;
+	int             returnValue = 0;
+
+	for (size_t i = 0; i < selectorCount; i++)
+	{
+		columns[i].heapPointer = NULL;
+		columns[i].size = 0;
+	}
+
+	if (columnIndices == NULL)
+	{
+		return 1;
+	}
+
+	/*
+	 *	The first line is a header if its first field is not a number.
+	 */
+	while (p < end && isWhitespace(*p))
+	{
+		p++;
+	}
+	lineEnd = findLineEnd(p, end);
+	{
+		float        value;
+		const char * fieldStart = skipBlanks(p, lineEnd);
+
+		hasHeader = (fieldStart < lineEnd && parseFloat(fieldStart, lineEnd, &value) == 0);
+	}
+
+	for (size_t i = 0; i < selectorCount; i++)
+	{
+		if (isColumnIndex(selectors[i]))
+		{
+			columnIndices[i] = atol(selectors[i]);
+		}
+		else if (hasHeader)
+		{
+			columnIndices[i] = findColumnByName(p, lineEnd, selectors[i]);
+		}
+		else
+		{
+			columnIndices[i] = -1;
+		}
+
+		if (columnIndices[i] < 0)
+		{
+			printf("Error: no column named '%s' in the CSV header\n", selectors[i]);
+			returnValue = 1;
+			goto RETURN;
+		}
+
+		if (columnIndices[i] > maximumColumn)
+		{
+			maximumColumn = columnIndices[i];
+		}
+	}
+
+	if (hasHeader)
+	{
+		p = (lineEnd < end) ? lineEnd + 1 : end;
+	}
+
+	rowValues = (double *)calloc(maximumColumn + 1, sizeof(double));
+	firstValues = (double *)calloc(selectorCount, sizeof(double));
+	isSelectedColumn = (unsigned char *)calloc(maximumColumn + 1, 1);
+	if (rowValues == NULL || firstValues == NULL || isSelectedColumn == NULL)
+	{
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	for (size_t i = 0; i < selectorCount; i++)
+	{
+		isSelectedColumn[columnIndices[i]] = 1;
+		columns[i].heapPointer = (float *)malloc(capacity * sizeof(float));
+		if (columns[i].heapPointer == NULL)
+		{
+			returnValue = 1;
+			goto RETURN;
+		}
+	}
+
+	/*
+	 *	Read rows until the end of the data or the first row that is missing a selected value.
+	 */
+	while (p < end)
+	{
+		lineEnd = findLineEnd(p, end);
+
+		if (isBlankLine(p, lineEnd))
+		{
+			p = lineEnd + 1;
+			continue;
+		}
+
+		if (parseRow(p, lineEnd, maximumColumn, rowValues, isSelectedColumn))
+		{
+			break;
+		}
+
+		if (rowCount == capacity)
+		{
+			for (size_t i = 0; i < selectorCount; i++)
+			{
+				float * const newPointer = (float *)reallocarray(
+					columns[i].heapPointer,
+					capacity * 2,
+					sizeof(float));
+
+				if (newPointer == NULL)
+				{
+					returnValue = 1;
+					goto RETURN;
+				}
+
+				columns[i].heapPointer = newPointer;
+			}
+			capacity *= 2;
+		}
+
+		for (size_t i = 0; i < selectorCount; i++)
+		{
+			columns[i].heapPointer[rowCount] = (float)rowValues[columnIndices[i]];
+			if (rowCount == 0)
+			{
+				firstValues[i] = rowValues[columnIndices[i]];
+			}
+			if (columnSpans != NULL)
+			{
+				columnSpans[i] = rowValues[columnIndices[i]] - firstValues[i];
+			}
+		}
+		rowCount++;
+
+		p = lineEnd + 1;
+	}
+
+	for (size_t i = 0; i < selectorCount; i++)
+	{
+		columns[i].size = rowCount;
+		shrinkBufferToFit(&columns[i], capacity);
+	}
+
+RETURN:
+	if (returnValue != 0)
+	{
+		for (size_t i = 0; i < selectorCount; i++)
+		{
+			free(columns[i].heapPointer);
+			columns[i].heapPointer = NULL;
+			columns[i].size = 0;
+		}
+	}
+
+	free(columnIndices);
+	free(rowValues);
+	free(firstValues);
+	free(isSelectedColumn);
+
+	return returnValue;
+}
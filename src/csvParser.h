@@ -0,0 +1,142 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "utils.h"
+#include <stddef.h>
+
+/**
+ *	@brief Incremental parser for the single column CSV format, fed with successive blocks of a
+ *	stream (e.g., the output of a decompressor).
+ *
+ */
+typedef struct CSVStreamParser
+{
+	Buffer values;
+	size_t capacity;
+	char * carry;
+	size_t carrySize;
+	size_t carryCapacity;
+	int    isStopped;
+} CSVStreamParser;
+
+/**
+ *	@brief Parse a floating point value from a character range that need not be NUL terminated.
+ *	@note Plain decimal values are converted without going through the C library. Other forms
+ *	accepted by strtof() (e.g., infinity, NaN, hexadecimal) fall back to strtof().
+ *
+ *	@param start   : Pointer to first character of the value.
+ *	@param end     : Pointer to one past the last character available.
+ *	@param value   : Pointer to location to store the parsed value.
+ *	@return size_t : Number of characters consumed, or 0 if no value could be parsed.
+ */
+size_t
+parseFloat(const char * const start, const char * const end, float * const value);
+
+/**
+ *	@brief Parse a double precision value from a character range that need not be NUL
+ *	terminated, as for parseFloat().
+ *
+ *	@param start   : Pointer to first character of the value.
+ *	@param end     : Pointer to one past the last character available.
+ *	@param value   : Pointer to location to store the parsed value.
+ *	@return size_t : Number of characters consumed, or 0 if no value could be parsed.
+ */
+size_t
+parseDouble(const char * const start, const char * const end, double * const value);
+
+/**
+ *	@brief Parse whitespace separated values, each optionally followed by a comma (the format
+ *	of the bundled input CSV files), into a heap Buffer.
+ *	@note Parsing stops at the end of the data or at the first value that cannot be parsed.
+ *	The buffer is empty (size 0, NULL pointer) if no values were found. Large inputs are split
+ *	into newline aligned chunks that are parsed in parallel, one thread per online processor.
+ *
+ *	@param data : Pointer to the characters to parse.
+ *	@param size : Number of characters to parse.
+ *	@param buf  : Pointer to Buffer to store the parsed values.
+ *	@return int : 0 if success, 1 if out of memory
+ */
+int
+parseFloatsFromCSV(const char * const data, const size_t size, Buffer * const buf);
+
+/**
+ *	@brief Parse selected columns of a multi-column CSV file into heap Buffers in one pass.
+ *	@note A selector is either a column index (counting from 0) or a column name, which is
+ *	matched case insensitively against the header line. The first line is treated as a header
+ *	if its first field is not a number. Reading stops at the end of the data or at the first
+ *	row that is missing a value in a selected column. All Buffers receive the same number of
+ *	values. Values are parsed in double precision and stored as floats.
+ *
+ *	@param data          : Pointer to the characters to parse.
+ *	@param size          : Number of characters to parse.
+ *	@param selectors     : Array of column selectors.
+ *	@param selectorCount : Number of column selectors.
+ *	@param columns       : Array of selectorCount Buffers to store the parsed columns.
+ *	@param columnSpans   : Array of selectorCount values to store the last minus the first
+ *	value of each column in double precision (may be NULL).
+ *	@return int          : 0 if success, 1 if a selector could not be resolved or out of memory
+ */
+int
+parseColumnsFromCSV(
+	const char * const         data,
+	const size_t               size,
+	const char * const * const selectors,
+	const size_t               selectorCount,
+	Buffer * const             columns,
+	double * const             columnSpans);
+
+/**
+ *	@brief Initialise an incremental CSV parser.
+ *
+ *	@param parser : Pointer to parser to initialise.
+ */
+void
+csvStreamParserInitialise(CSVStreamParser * const parser);
+
+/**
+ *	@brief Parse the next block of a stream.
+ *	@note Values are parsed up to the last line break of the block. The remainder is carried
+ *	over to the next block. After the first value that cannot be parsed, further input is
+ *	ignored.
+ *
+ *	@param parser : Pointer to parser.
+ *	@param data   : Pointer to the characters of the block.
+ *	@param size   : Number of characters in the block.
+ *	@return int   : 0 if success, 1 if out of memory
+ */
+int
+csvStreamParserFeed(CSVStreamParser * const parser, const char * const data, const size_t size);
+
+/**
+ *	@brief Parse any carried over characters and hand the parsed values over to a Buffer.
+ *	@note The parser holds no memory afterwards.
+ *
+ *	@param parser : Pointer to parser.
+ *	@param buf    : Pointer to Buffer to store the parsed values (empty if none were found).
+ *	@return int   : 0 if success, 1 if out of memory
+ */
+int
+csvStreamParserFinish(CSVStreamParser * const parser, Buffer * const buf);
@@ -0,0 +1,420 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "directionalSpectrum.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const double kSpreadingDiagonalLoading = 1e-3;
+
+static const char * const kDirectionalMethodNames[kDirectionalMethodMaximum] = {
+	"mem",
+	"mlm",
+};
+
+int
+estimateCrossSpectralMatrix(
+	CrossSpectralMatrix * const matrices,
+	const float * const         heave,
+	const float * const         slopeX,
+	const float * const         slopeY,
+	const size_t                sampleCount,
+	const size_t                segmentSize,
+	const float                 timestep)
+{
+	const size_t L = segmentSize;
+	const size_t hop = L / 2 > 0 ? L / 2 : 1;
+	const size_t segmentCount = sampleCount > L ? 1 + (sampleCount - L) / hop : 1;
+	const size_t binCount = L / 2 + 1;
+	const size_t windowLength = segmentCount > 1 || sampleCount > L ? L : sampleCount;
+	const WindowType window = segmentCount > 1 ? kWindowHann : kWindowRectangular;
+	Complex *    z = (Complex *)malloc(2 * L * sizeof(Complex));
+	Complex *    Z = (Complex *)malloc(2 * L * sizeof(Complex));
+	double       scale;
+
+	if (z == NULL || Z == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		free(z);
+		free(Z);
+		return 1;
+	}
+
+	memset(matrices, 0, binCount * sizeof(CrossSpectralMatrix));
+
+	for (size_t segment = 0; segment < segmentCount; segment++)
+	{
+		const size_t start = segment * hop;
+		const size_t length = sampleCount - start < L ? sampleCount - start : L;
+
+		/*
+		 *	Pack heave and the x slope into the real and imaginary parts of one FFT
+		 *	input, and the y slope into the real part of a second.
+		 */
+		for (size_t n = 0; n < L; n++)
+		{
+			const float coefficient =
+				segmentCount > 1 ? windowCoefficient(kWindowHann, n, L) : 1;
+
+			z[n].real = n < length ? coefficient * heave[start + n] : 0;
+			z[n].imaginary = n < length ? coefficient * slopeX[start + n] : 0;
+			z[L + n].real = n < length ? coefficient * slopeY[start + n] : 0;
+			z[L + n].imaginary = 0;
+		}
+
+		complexFFT(Z, z, L);
+		complexFFT(Z + L, z + L, L);
+
+		for (size_t k = 0; k < binCount; k++)
+		{
+			const Complex a = Z[k];
+			const Complex b = Z[(L - k) % L];
+			const double  XReal[kDirectionalChannelCount] = {
+				0.5 * (a.real + b.real),
+				0.5 * (a.imaginary + b.imaginary),
+				Z[L + k].real,
+			};
+			const double XImaginary[kDirectionalChannelCount] = {
+				0.5 * (a.imaginary - b.imaginary),
+				-0.5 * (a.real - b.real),
+				Z[L + k].imaginary,
+			};
+
+			for (size_t i = 0; i < kDirectionalChannelCount; i++)
+			{
+				for (size_t j = i; j < kDirectionalChannelCount; j++)
+				{
+					matrices[k].coincident[i][j] +=
+						XReal[i] * XReal[j] + XImaginary[i] * XImaginary[j];
+					matrices[k].quadrature[i][j] +=
+						XReal[i] * XImaginary[j] - XImaginary[i] * XReal[j];
+				}
+			}
+		}
+	}
+
+	/*
+	 *	Scale to one-sided densities, allowing for the power the window removes, and fill in
+	 *	the lower triangle of each Hermitian matrix.
+	 */
+	scale = 2.0 * timestep / (segmentCount * windowLength * windowPower(window, windowLength));
+	for (size_t k = 0; k < binCount; k++)
+	{
+		for (size_t i = 0; i < kDirectionalChannelCount; i++)
+		{
+			for (size_t j = i; j < kDirectionalChannelCount; j++)
+			{
+				matrices[k].coincident[i][j] *= scale;
+				matrices[k].quadrature[i][j] *= scale;
+				matrices[k].coincident[j][i] = matrices[k].coincident[i][j];
+				matrices[k].quadrature[j][i] = -matrices[k].quadrature[i][j];
+			}
+		}
+	}
+
+	free(z);
+	free(Z);
+	return 0;
+}
+
+/**
+ *	@brief Maximum Entropy Method estimate of the spreading function from its first four
+ *	Fourier coefficients (Lygre and Krogstad).
+ */
+static void
+maximumEntropySpreading(DirectionalBin * const bin, const double binWidth)
+{
+	const double PI = acos(-1);
+	double       loading = kSpreadingDiagonalLoading;
+	double       phi1Real;
+	double       phi1Imaginary;
+	double       phi2Real;
+	double       phi2Imaginary;
+	double       numerator;
+
+	/*
+	 *	Loading the diagonal of the Toeplitz matrix of the coefficients shrinks c1 and c2
+	 *	together. Waves from a single direction, or estimates that are not a valid moment
+	 *	sequence, would otherwise leave no positive prediction error.
+	 */
+	for (size_t step = 0; step < kMaximumLoadingSteps; step++, loading *= 10)
+	{
+		const double c1Real = bin->a1 / (1 + loading);
+		const double c1Imaginary = bin->b1 / (1 + loading);
+		const double c2Real = bin->a2 / (1 + loading);
+		const double c2Imaginary = bin->b2 / (1 + loading);
+		const double denominator = 1 - (c1Real * c1Real + c1Imaginary * c1Imaginary);
+
+		/*
+		 *	phi1 = (c1 - c2 conj(c1)) / (1 - |c1|^2), phi2 = c2 - c1 phi1.
+		 */
+		phi1Real = (c1Real - (c2Real * c1Real + c2Imaginary * c1Imaginary)) / denominator;
+		phi1Imaginary =
+			(c1Imaginary - (c2Imaginary * c1Real - c2Real * c1Imaginary)) / denominator;
+		phi2Real = c2Real - (c1Real * phi1Real - c1Imaginary * phi1Imaginary);
+		phi2Imaginary = c2Imaginary - (c1Real * phi1Imaginary + c1Imaginary * phi1Real);
+
+		/*
+		 *	The prediction error 1 - phi1 conj(c1) - phi2 conj(c2), which is real.
+		 */
+		numerator = 1 - (phi1Real * c1Real + phi1Imaginary * c1Imaginary) -
+			    (phi2Real * c2Real + phi2Imaginary * c2Imaginary);
+
+		if (denominator > 0 && numerator > 0)
+		{
+			break;
+		}
+	}
+
+	for (size_t j = 0; j < kDirectionalBinCount; j++)
+	{
+		const double theta = j * binWidth;
+		const double vReal = 1 - phi1Real * cos(theta) - phi1Imaginary * sin(theta) -
+				     phi2Real * cos(2 * theta) - phi2Imaginary * sin(2 * theta);
+		const double vImaginary =
+			phi1Real * sin(theta) - phi1Imaginary * cos(theta) +
+			phi2Real * sin(2 * theta) - phi2Imaginary * cos(2 * theta);
+
+		bin->spreading[j] =
+			numerator / (2 * PI * (vReal * vReal + vImaginary * vImaginary));
+	}
+}
+
+/**
+ *	@brief Maximum Likelihood Method estimate of the spreading function from the cross-spectral
+ *	matrix normalised to unit heave and unit wavenumber.
+ */
+static void
+maximumLikelihoodSpreading(DirectionalBin * const bin, const double binWidth)
+{
+	const double m00 = 1 + kSpreadingDiagonalLoading;
+	const double m01 = bin->a1;
+	const double m02 = bin->b1;
+	const double m11 = (1 + bin->a2) / 2 + kSpreadingDiagonalLoading;
+	const double m12 = bin->b2 / 2;
+	const double m22 = (1 - bin->a2) / 2 + kSpreadingDiagonalLoading;
+
+	/*
+	 *	The adjugate of the symmetric matrix. Its determinant only scales the estimate, and
+	 *	the estimate is normalised afterwards.
+	 */
+	const double i00 = m11 * m22 - m12 * m12;
+	const double i01 = m02 * m12 - m01 * m22;
+	const double i02 = m01 * m12 - m02 * m11;
+	const double i11 = m00 * m22 - m02 * m02;
+	const double i12 = m01 * m02 - m00 * m12;
+	const double i22 = m00 * m11 - m01 * m01;
+
+	for (size_t j = 0; j < kDirectionalBinCount; j++)
+	{
+		const double c = cos(j * binWidth);
+		const double s = sin(j * binWidth);
+		const double quadraticForm = i00 + 2 * i01 * c + 2 * i02 * s + i11 * c * c +
+					     2 * i12 * c * s + i22 * s * s;
+
+		bin->spreading[j] = 1 / quadraticForm;
+	}
+}
+
+void
+estimateDirectionalSpreading(
+	DirectionalBin * const            bin,
+	const CrossSpectralMatrix * const matrix,
+	const DirectionalMethodType       method)
+{
+	const double PI = acos(-1);
+	const double radiansToDegrees = 180 / PI;
+	const double binWidth = 2 * PI / kDirectionalBinCount;
+	const double heavePower = matrix->coincident[0][0];
+	const double slopePower = matrix->coincident[1][1] + matrix->coincident[2][2];
+	const double firstHarmonicScale = sqrt(heavePower * slopePower);
+	double       total = 0;
+	size_t       peak = 0;
+
+	/*
+	 *	A wave travelling towards theta puts the slopes a quarter period behind heave, at
+	 *	-i k cos(theta) and -i k sin(theta) times the heave spectrum. Normalising by the
+	 *	measured wavenumber k = sqrt(slopePower / heavePower) removes the dispersion
+	 *	relation.
+	 */
+	bin->energy = heavePower;
+	bin->a1 = firstHarmonicScale > 0 ? -matrix->quadrature[0][1] / firstHarmonicScale : 0;
+	bin->b1 = firstHarmonicScale > 0 ? -matrix->quadrature[0][2] / firstHarmonicScale : 0;
+	bin->a2 = slopePower > 0
+			  ? (matrix->coincident[1][1] - matrix->coincident[2][2]) / slopePower
+			  : 0;
+	bin->b2 = slopePower > 0 ? 2 * matrix->coincident[1][2] / slopePower : 0;
+
+	bin->meanDirection = atan2(bin->b1, bin->a1) * radiansToDegrees;
+	if (bin->meanDirection < 0)
+	{
+		bin->meanDirection += 360;
+	}
+	{
+		const double firstHarmonic = hypot(bin->a1, bin->b1);
+
+		bin->directionalSpread =
+			sqrt(2 * (firstHarmonic < 1 ? 1 - firstHarmonic : 0)) * radiansToDegrees;
+	}
+
+	switch (method)
+	{
+	case kDirectionalMethodMLM:
+		maximumLikelihoodSpreading(bin, binWidth);
+		break;
+	case kDirectionalMethodMEM:
+	default:
+		maximumEntropySpreading(bin, binWidth);
+		break;
+	}
+
+	for (size_t j = 0; j < kDirectionalBinCount; j++)
+	{
+		total += bin->spreading[j] * binWidth;
+		if (bin->spreading[j] > bin->spreading[peak])
+		{
+			peak = j;
+		}
+	}
+
+	for (size_t j = 0; j < kDirectionalBinCount; j++)
+	{
+		bin->spreading[j] = total > 0 && isfinite(total) ? bin->spreading[j] / total
+								  : 1 / (2 * PI);
+	}
+
+	bin->peakDirection = peak * binWidth * radiansToDegrees;
+}
+
+typedef struct DirectionalWorker
+{
+	DirectionalBin *            bins;
+	const CrossSpectralMatrix * matrices;
+	size_t                      binCount;
+	DirectionalMethodType       method;
+	size_t                      first;
+	size_t                      stride;
+	pthread_t                   thread;
+} DirectionalWorker;
+
+static void *
+directionalWorkerBins(void * argument)
+{
+	DirectionalWorker * const worker = (DirectionalWorker *)argument;
+
+	for (size_t k = worker->first; k < worker->binCount; k += worker->stride)
+	{
+		estimateDirectionalSpreading(
+			&worker->bins[k],
+			&worker->matrices[k],
+			worker->method);
+	}
+
+	return NULL;
+}
+
+void
+estimateDirectionalSpectrum(
+	DirectionalBin * const            bins,
+	const CrossSpectralMatrix * const matrices,
+	const size_t                      binCount,
+	const DirectionalMethodType       method,
+	size_t                            threadCount)
+{
+	DirectionalWorker workers[kDirectionalMaximumThreads];
+	int               isThreadRunning[kDirectionalMaximumThreads] = {0};
+
+	if (threadCount > kDirectionalMaximumThreads)
+	{
+		threadCount = kDirectionalMaximumThreads;
+	}
+	if (threadCount > binCount)
+	{
+		threadCount = binCount;
+	}
+	if (threadCount == 0)
+	{
+		threadCount = 1;
+	}
+
+	for (size_t t = 0; t < threadCount; t++)
+	{
+		workers[t] = (DirectionalWorker){
+			.bins = bins,
+			.matrices = matrices,
+			.binCount = binCount,
+			.method = method,
+			.first = t,
+			.stride = threadCount,
+		};
+
+		/*
+		 *	The calling thread takes the first share of the bins itself.
+		 */
+		if (t > 0)
+		{
+			isThreadRunning[t] = pthread_create(
+						     &workers[t].thread,
+						     NULL,
+						     directionalWorkerBins,
+						     &workers[t]) == 0;
+		}
+	}
+
+	for (size_t t = 0; t < threadCount; t++)
+	{
+		if (!isThreadRunning[t])
+		{
+			directionalWorkerBins(&workers[t]);
+		}
+	}
+
+	for (size_t t = 0; t < threadCount; t++)
+	{
+		if (isThreadRunning[t])
+		{
+			pthread_join(workers[t].thread, NULL);
+		}
+	}
+}
+
+int
+parseDirectionalMethodType(const char * const name, DirectionalMethodType * const method)
+{
+	for (size_t i = 0; i < kDirectionalMethodMaximum; i++)
+	{
+		if (strcmp(name, kDirectionalMethodNames[i]) == 0)
+		{
+			*method = (DirectionalMethodType)i;
+			return 0;
+		}
+	}
+
+	return 1;
+}
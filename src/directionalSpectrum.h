@@ -0,0 +1,154 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "signalProcessing.h"
+#include <stddef.h>
+
+typedef enum
+{
+	kDirectionalChannelCount = 3,
+	kDirectionalBinCount = 72,
+	kDirectionalMaximumThreads = 64,
+	kMaximumLoadingSteps = 6,
+} DirectionalSpectrumConstants;
+
+typedef enum
+{
+	kDirectionalMethodMEM,
+	kDirectionalMethodMLM,
+	kDirectionalMethodMaximum,
+} DirectionalMethodType;
+
+/**
+ *	@brief Cross-spectral matrix of heave and the two slopes (or horizontal displacements) at
+ *	one frequency, as one-sided spectral densities.
+ *	@note With channel spectra X, coincident[i][j] + i quadrature[i][j] is the Welch average of
+ *	conj(X_i) X_j. Channels are, in order, heave, slope along x and slope along y.
+ *
+ */
+typedef struct CrossSpectralMatrix
+{
+	double coincident[kDirectionalChannelCount][kDirectionalChannelCount];
+	double quadrature[kDirectionalChannelCount][kDirectionalChannelCount];
+} CrossSpectralMatrix;
+
+/**
+ *	@brief Directional distribution of the wave energy at one frequency.
+ *	@note Directions are those the waves travel towards, in degrees anticlockwise from the x
+ *	axis. The spreading function is in 1/radian over kDirectionalBinCount equal direction bins
+ *	from 0 degrees, and integrates to one.
+ *
+ */
+typedef struct DirectionalBin
+{
+	float energy;
+	/*
+	 *	First and second order Fourier coefficients of the spreading function
+	 */
+	float a1;
+	float b1;
+	float a2;
+	float b2;
+	float meanDirection;
+	float directionalSpread;
+	float peakDirection;
+	float spreading[kDirectionalBinCount];
+} DirectionalBin;
+
+/**
+ *	@brief Estimate the cross-spectral matrix of heave and slope measurements by Welch
+ *	averaging.
+ *	@note Segments overlap by half and are Hann windowed when the record spans more than one
+ *	segment. Heave and the x slope share one complex FFT per segment, and every matrix element
+ *	comes from the same three channel spectra.
+ *
+ *	@param matrices    : Pointer to array to store segmentSize / 2 + 1 matrices, from 0 Hz.
+ *	@param heave       : Pointer to buffer containing heave displacement measurements.
+ *	@param slopeX      : Pointer to buffer containing slope (e.g., pitch) measurements along x.
+ *	@param slopeY      : Pointer to buffer containing slope (e.g., roll) measurements along y.
+ *	@param sampleCount : Number of measurements in each buffer.
+ *	@param segmentSize : Welch segment length. Must be a power of two. Records shorter than one
+ *	segment are zero padded.
+ *	@param timestep    : Time period between successive measurements.
+ *	@return int        : 0 if success, 1 if error encountered
+ */
+int
+estimateCrossSpectralMatrix(
+	CrossSpectralMatrix * const matrices,
+	const float * const         heave,
+	const float * const         slopeX,
+	const float * const         slopeY,
+	const size_t                sampleCount,
+	const size_t                segmentSize,
+	const float                 timestep);
+
+/**
+ *	@brief Estimate the directional spreading function at one frequency.
+ *	@note The Fourier coefficients are normalised by the measured wavenumber, so the dispersion
+ *	relation and the slope units are not needed. The Maximum Entropy Method is that of Lygre
+ *	and Krogstad, and the Maximum Likelihood Method inverts the normalised 3x3 cross-spectral
+ *	matrix. Both load the diagonal of their matrix slightly, so that they stay defined for
+ *	waves from a single direction.
+ *
+ *	@param bin    : Pointer to DirectionalBin to store the result.
+ *	@param matrix : Pointer to cross-spectral matrix at the frequency.
+ *	@param method : Estimation method.
+ */
+void
+estimateDirectionalSpreading(
+	DirectionalBin * const            bin,
+	const CrossSpectralMatrix * const matrix,
+	const DirectionalMethodType       method);
+
+/**
+ *	@brief Estimate the directional spreading function at every frequency in parallel.
+ *	@note Bins are shared out between the threads in a fixed interleaved order, and the result
+ *	does not depend on the number of threads. If a thread cannot be created, the calling thread
+ *	estimates its bins.
+ *
+ *	@param bins        : Pointer to array of binCount DirectionalBins to store the results.
+ *	@param matrices    : Pointer to array of binCount cross-spectral matrices.
+ *	@param binCount    : Number of frequency bins.
+ *	@param method      : Estimation method.
+ *	@param threadCount : Number of threads (at most kDirectionalMaximumThreads).
+ */
+void
+estimateDirectionalSpectrum(
+	DirectionalBin * const            bins,
+	const CrossSpectralMatrix * const matrices,
+	const size_t                      binCount,
+	const DirectionalMethodType       method,
+	size_t                            threadCount);
+
+/**
+ *	@brief Parse a directional estimation method name.
+ *
+ *	@param name   : Method name ("mem" or "mlm").
+ *	@param method : Pointer to location to store the parsed method.
+ *	@return int   : 0 if success, 1 if the name is not recognised
+ */
+int
+parseDirectionalMethodType(const char * const name, DirectionalMethodType * const method);
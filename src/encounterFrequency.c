@@ -0,0 +1,207 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "encounterFrequency.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static const double kGravitationalAcceleration = 9.80665;
+static const float  kSpeedBucket = 0.1;
+static const float  kHeadingBucket = 1;
+
+int
+buildEncounterMapping(
+	EncounterMapping * const mapping,
+	const float              speed,
+	const float              heading,
+	const size_t             binCount,
+	const double             frequencyStep)
+{
+	const double PI = acos(-1);
+	/*
+	 *	fe = f - a f^2, which peaks at fe = 1 / (4 a) for following seas (a > 0).
+	 */
+	const double a = 2 * PI * speed * cos(heading * PI / 180) / kGravitationalAcceleration;
+
+	mapping->speed = speed;
+	mapping->heading = heading;
+	mapping->binCount = binCount;
+	mapping->frequencyStep = frequencyStep;
+	mapping->indices = (uint32_t *)malloc(binCount * sizeof(uint32_t));
+	mapping->weights = (float *)malloc(binCount * sizeof(float));
+	mapping->scales = (float *)malloc(binCount * sizeof(float));
+
+	if (mapping->indices == NULL || mapping->weights == NULL || mapping->scales == NULL ||
+	    binCount > UINT32_MAX)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		freeEncounterMapping(mapping);
+		return 1;
+	}
+
+	for (size_t i = 0; i < binCount; i++)
+	{
+		const double f = i * frequencyStep;
+		const double encounterFrequency = fabs(f - a * f * f);
+		const double position = encounterFrequency / frequencyStep;
+		const double index = floor(position);
+		const double maximumFrequency = binCount * frequencyStep;
+		double       branchCount = 1;
+
+		if (index + 1 >= binCount)
+		{
+			/*
+			 *	Encountered above the highest measured frequency.
+			 */
+			mapping->indices[i] = 0;
+			mapping->weights[i] = 0;
+			mapping->scales[i] = 0;
+			continue;
+		}
+
+		/*
+		 *	In following seas an encounter frequency below 1 / (4 a) also comes from the other
+		 *	two roots of a f^2 - f + fe = 0 and from a f^2 - f - fe = 0. The energy is shared
+		 *	between the absolute frequencies that lie on the grid.
+		 */
+		if (a > 0 && 4 * a * encounterFrequency < 1)
+		{
+			const double root = sqrt(1 - 4 * a * encounterFrequency);
+			const double branches[3] = {
+				2 * encounterFrequency / (1 + root),
+				(1 + root) / (2 * a),
+				(1 + sqrt(1 + 4 * a * encounterFrequency)) / (2 * a),
+			};
+
+			branchCount = 0;
+			for (size_t j = 0; j < 3; j++)
+			{
+				branchCount += branches[j] < maximumFrequency;
+			}
+			branchCount = branchCount > 0 ? branchCount : 1;
+		}
+
+		mapping->indices[i] = (uint32_t)index;
+		mapping->weights[i] = position - index;
+		mapping->scales[i] = fabs(1 - 2 * a * f) / branchCount;
+	}
+
+	return 0;
+}
+
+void
+freeEncounterMapping(EncounterMapping * const mapping)
+{
+	free(mapping->indices);
+	free(mapping->weights);
+	free(mapping->scales);
+	mapping->indices = NULL;
+	mapping->weights = NULL;
+	mapping->scales = NULL;
+	mapping->binCount = 0;
+}
+
+void
+applyEncounterMapping(
+	const EncounterMapping * const mapping,
+	float * const                  absoluteSpectrum,
+	const float * const            encounterSpectrum)
+{
+	const uint32_t * const indices = mapping->indices;
+	const float * const    weights = mapping->weights;
+	const float * const    scales = mapping->scales;
+
+	for (size_t i = 0; i < mapping->binCount; i++)
+	{
+		const float lower = encounterSpectrum[indices[i]];
+		const float upper = encounterSpectrum[indices[i] + 1];
+
+		absoluteSpectrum[i] = scales[i] * (lower + weights[i] * (upper - lower));
+	}
+}
+
+int
+lookupEncounterMapping(
+	EncounterMappingCache * const   cache,
+	const float                     speed,
+	const float                     heading,
+	const size_t                    binCount,
+	const double                    frequencyStep,
+	const EncounterMapping ** const mapping)
+{
+	const float bucketSpeed = roundf(speed / kSpeedBucket) * kSpeedBucket;
+	const float bucketHeading = roundf(heading / kHeadingBucket) * kHeadingBucket;
+	size_t      leastRecent = 0;
+
+	cache->useCount++;
+
+	for (size_t i = 0; i < kEncounterMappingCacheSize; i++)
+	{
+		EncounterMapping * const entry = &cache->entries[i];
+
+		if (entry->indices != NULL && entry->speed == bucketSpeed &&
+		    entry->heading == bucketHeading && entry->binCount == binCount &&
+		    entry->frequencyStep == frequencyStep)
+		{
+			cache->lastUse[i] = cache->useCount;
+			*mapping = entry;
+			return 0;
+		}
+
+		if (cache->lastUse[i] < cache->lastUse[leastRecent])
+		{
+			leastRecent = i;
+		}
+	}
+
+	freeEncounterMapping(&cache->entries[leastRecent]);
+	cache->lastUse[leastRecent] = 0;
+	if (buildEncounterMapping(
+		    &cache->entries[leastRecent],
+		    bucketSpeed,
+		    bucketHeading,
+		    binCount,
+		    frequencyStep))
+	{
+		return 1;
+	}
+
+	cache->lastUse[leastRecent] = cache->useCount;
+	*mapping = &cache->entries[leastRecent];
+
+	return 0;
+}
+
+void
+freeEncounterMappingCache(EncounterMappingCache * const cache)
+{
+	for (size_t i = 0; i < kEncounterMappingCacheSize; i++)
+	{
+		freeEncounterMapping(&cache->entries[i]);
+		cache->lastUse[i] = 0;
+	}
+}
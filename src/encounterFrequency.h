@@ -0,0 +1,139 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum
+{
+	kEncounterMappingCacheSize = 8,
+} EncounterMappingConstants;
+
+/**
+ *	@brief Table that maps a spectrum over encounter frequency onto absolute frequency, for one
+ *	vessel speed and heading.
+ *	@note Each absolute frequency bin reads a linearly interpolated encounter bin and scales it
+ *	by the Jacobian of the mapping, so applying the table is a single gather and multiply.
+ *
+ */
+typedef struct EncounterMapping
+{
+	float      speed;
+	float      heading;
+	size_t     binCount;
+	double     frequencyStep;
+	uint32_t * indices;
+	float *    weights;
+	float *    scales;
+} EncounterMapping;
+
+/**
+ *	@brief Least recently used cache of encounter mappings, keyed by speed and heading buckets.
+ *
+ */
+typedef struct EncounterMappingCache
+{
+	EncounterMapping entries[kEncounterMappingCacheSize];
+	uint64_t         lastUse[kEncounterMappingCacheSize];
+	uint64_t         useCount;
+} EncounterMappingCache;
+
+/**
+ *	@brief Build the table mapping encounter frequency to absolute frequency.
+ *	@note With deep water dispersion, a wave of absolute frequency f is encountered at
+ *	fe = f - 2 pi f^2 U cos(mu) / g, where U is the vessel speed and mu the heading relative to
+ *	the waves (0 degrees for following seas, 180 degrees for head seas). In following seas a
+ *	measured encounter frequency below g / (8 pi U cos(mu)) comes from three absolute
+ *	frequencies, and its energy is split equally between them. Both spectra share the same bins.
+ *
+ *	@param mapping       : Pointer to EncounterMapping to build (release with
+ *	freeEncounterMapping()).
+ *	@param speed         : Vessel speed in m/s.
+ *	@param heading       : Vessel heading relative to the waves in degrees.
+ *	@param binCount      : Number of bins from 0 Hz.
+ *	@param frequencyStep : Frequency resolution in Hz.
+ *	@return int          : 0 if success, 1 if error encountered
+ */
+int
+buildEncounterMapping(
+	EncounterMapping * const mapping,
+	const float              speed,
+	const float              heading,
+	const size_t             binCount,
+	const double             frequencyStep);
+
+/**
+ *	@brief Release the tables of an encounter mapping.
+ *
+ *	@param mapping : Pointer to EncounterMapping.
+ */
+void
+freeEncounterMapping(EncounterMapping * const mapping);
+
+/**
+ *	@brief Map a spectrum over encounter frequency onto absolute frequency.
+ *
+ *	@param mapping           : Pointer to EncounterMapping.
+ *	@param absoluteSpectrum  : Pointer to buffer to store mapping->binCount bins.
+ *	@param encounterSpectrum : Pointer to buffer containing mapping->binCount bins (must not
+ *	be the same buffer as absoluteSpectrum).
+ */
+void
+applyEncounterMapping(
+	const EncounterMapping * const mapping,
+	float * const                  absoluteSpectrum,
+	const float * const            encounterSpectrum);
+
+/**
+ *	@brief Get the encounter mapping for the speed and heading bucket of a vessel, building it
+ *	if it is not cached.
+ *	@note Speeds are bucketed to 0.1 m/s and headings to 1 degree, so the tables are only
+ *	rebuilt when the vessel's course or speed changes noticeably.
+ *
+ *	@param cache         : Pointer to zero initialised EncounterMappingCache.
+ *	@param speed         : Vessel speed in m/s.
+ *	@param heading       : Vessel heading relative to the waves in degrees.
+ *	@param binCount      : Number of bins from 0 Hz.
+ *	@param frequencyStep : Frequency resolution in Hz.
+ *	@param mapping       : Pointer to location to store a pointer to the cached mapping.
+ *	@return int          : 0 if success, 1 if error encountered
+ */
+int
+lookupEncounterMapping(
+	EncounterMappingCache * const   cache,
+	const float                     speed,
+	const float                     heading,
+	const size_t                    binCount,
+	const double                    frequencyStep,
+	const EncounterMapping ** const mapping);
+
+/**
+ *	@brief Release every mapping in an encounter mapping cache.
+ *
+ *	@param cache : Pointer to EncounterMappingCache.
+ */
+void
+freeEncounterMappingCache(EncounterMappingCache * const cache);
@@ -0,0 +1,148 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "fileMapping.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef enum
+{
+	kFileReadChunkSize = 1 << 16,
+} FileMappingConstants;
+
+/**
+ *	@brief Read the whole of a file descriptor into a heap allocation.
+ *
+ *	@param fd   : File descriptor to read from.
+ *	@param file : Pointer to MappedFile to store the file contents.
+ *	@return int : 0 if success, 1 if error encountered
+ */
+static int
+readFileToHeap(const int fd, MappedFile * const file)
+{
+	char *  data = NULL;
+	size_t  capacity = 0;
+	size_t  size = 0;
+	ssize_t bytesRead;
+
+	do
+	{
+		if (capacity - size < kFileReadChunkSize)
+		{
+			char * const newData = (char *)realloc(data, capacity * 2 + kFileReadChunkSize);
+
+			if (newData == NULL)
+			{
+				free(data);
+				return 1;
+			}
+
+			data = newData;
+			capacity = capacity * 2 + kFileReadChunkSize;
+		}
+
+		bytesRead = read(fd, data + size, capacity - size);
+		if (bytesRead < 0)
+		{
+			free(data);
+			return 1;
+		}
+
+		size += bytesRead;
+	} while (bytesRead > 0);
+
+	file->data = data;
+	file->size = size;
+	file->isMapped = 0;
+
+	return 0;
+}
+
+int
+mapFile(const char * const filePath, MappedFile * const file)
+{
+	struct stat status;
+	void *      data;
+	int         returnValue = 0;
+	const int   fd = open(filePath, O_RDONLY);
+
+	file->data = NULL;
+	file->size = 0;
+	file->isMapped = 0;
+
+	if (fd < 0)
+	{
+		printf("Error: could not open file at path '%s'\n", filePath);
+		return 1;
+	}
+
+	if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0)
+	{
+		data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED)
+		{
+			/*
+			 *	The file is read front to back.
+			 */
+			madvise(data, status.st_size, MADV_SEQUENTIAL);
+
+			file->data = (const char *)data;
+			file->size = status.st_size;
+			file->isMapped = 1;
+			close(fd);
+			return 0;
+		}
+	}
+
+	if (readFileToHeap(fd, file))
+	{
+		printf("Error: failed to read data from file at path '%s'\n", filePath);
+		returnValue = 1;
+	}
+
+	close(fd);
+
+	return returnValue;
+}
+
+void
+unmapFile(MappedFile * const file)
+{
+	if (file->isMapped)
+	{
+		munmap((void *)file->data, file->size);
+	}
+	else
+	{
+		free((void *)file->data);
+	}
+
+	file->data = NULL;
+	file->size = 0;
+	file->isMapped = 0;
+}
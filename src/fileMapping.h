@@ -0,0 +1,58 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/**
+ *	@brief Contents of a file mapped into memory (read only).
+ *	@note When the file cannot be memory mapped (e.g., a pipe or character device), its contents
+ *	are read into a heap allocation instead.
+ *
+ */
+typedef struct MappedFile
+{
+	const char * data;
+	size_t       size;
+	int          isMapped;
+} MappedFile;
+
+/**
+ *	@brief Map the contents of a file into memory for reading.
+ *
+ *	@param filePath : Path to file.
+ *	@param file     : Pointer to MappedFile to store the mapping.
+ *	@return int     : 0 if success, 1 if error encountered
+ */
+int
+mapFile(const char * const filePath, MappedFile * const file);
+
+/**
+ *	@brief Release a file mapping created with mapFile().
+ *
+ *	@param file : Pointer to MappedFile to release.
+ */
+void
+unmapFile(MappedFile * const file);
@@ -0,0 +1,146 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "inputPrefetch.h"
+#include <stdlib.h>
+
+/**
+ *	@brief Read the prefetch's input file. Runs on the prefetch thread.
+ */
+static void *
+readInput(void * argument)
+{
+	InputPrefetch * const prefetch = (InputPrefetch *)argument;
+
+	if (prefetch->selectors == NULL)
+	{
+		prefetch->returnValue = readSamplesFromFileToHeapBuffer(
+			prefetch->filePath,
+			prefetch->scaling,
+			&prefetch->columns[0],
+			&prefetch->info);
+	}
+	else
+	{
+		prefetch->returnValue = readColumnsFromFileToHeapBuffers(
+			prefetch->filePath,
+			prefetch->selectors,
+			prefetch->selectorCount,
+			prefetch->columns,
+			&prefetch->info);
+	}
+
+	return NULL;
+}
+
+static void
+startReading(InputPrefetch * const prefetch)
+{
+	for (size_t i = 0; i < kMaximumPrefetchColumns; i++)
+	{
+		prefetch->columns[i].heapPointer = NULL;
+		prefetch->columns[i].size = 0;
+	}
+	prefetch->returnValue = 0;
+
+	prefetch->isRunning = (pthread_create(&prefetch->thread, NULL, readInput, prefetch) == 0);
+	if (!prefetch->isRunning)
+	{
+		readInput(prefetch);
+	}
+}
+
+void
+inputPrefetchStart(
+	InputPrefetch * const      prefetch,
+	const char * const         filePath,
+	const CountScaling * const scaling)
+{
+	prefetch->filePath = filePath;
+	prefetch->scaling = scaling;
+	prefetch->selectors = NULL;
+	prefetch->selectorCount = 1;
+	startReading(prefetch);
+}
+
+void
+inputPrefetchStartColumns(
+	InputPrefetch * const      prefetch,
+	const char * const         filePath,
+	const char * const * const selectors,
+	const size_t               selectorCount)
+{
+	prefetch->filePath = filePath;
+	prefetch->scaling = NULL;
+	prefetch->selectors = selectors;
+	prefetch->selectorCount =
+		selectorCount < kMaximumPrefetchColumns ? selectorCount : kMaximumPrefetchColumns;
+	startReading(prefetch);
+}
+
+/**
+ *	@brief Join the prefetch thread if it is still running.
+ */
+static void
+joinPrefetch(InputPrefetch * const prefetch)
+{
+	if (prefetch->isRunning)
+	{
+		pthread_join(prefetch->thread, NULL);
+		prefetch->isRunning = 0;
+	}
+}
+
+int
+inputPrefetchWait(InputPrefetch * const prefetch, Buffer * const columns, InputFileInfo * const info)
+{
+	joinPrefetch(prefetch);
+
+	for (size_t i = 0; i < prefetch->selectorCount; i++)
+	{
+		columns[i] = prefetch->columns[i];
+		prefetch->columns[i].heapPointer = NULL;
+		prefetch->columns[i].size = 0;
+	}
+
+	if (info != NULL)
+	{
+		*info = prefetch->info;
+	}
+
+	return prefetch->returnValue;
+}
+
+void
+inputPrefetchRelease(InputPrefetch * const prefetch)
+{
+	joinPrefetch(prefetch);
+
+	for (size_t i = 0; i < kMaximumPrefetchColumns; i++)
+	{
+		freeHeapBuffer(&prefetch->columns[i]);
+		prefetch->columns[i].heapPointer = NULL;
+		prefetch->columns[i].size = 0;
+	}
+}
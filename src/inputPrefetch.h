@@ -0,0 +1,106 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "utils.h"
+#include <pthread.h>
+#include <stddef.h>
+
+typedef enum
+{
+	kMaximumPrefetchColumns = 4,
+} InputPrefetchConstants;
+
+/**
+ *	@brief Input file read on a background thread.
+ *	@note A prefetch either reads the first channel of a file (one column) or selected columns
+ *	of a multi-column file. The buffers are owned by the prefetch until they are claimed with
+ *	inputPrefetchWait().
+ *
+ */
+typedef struct InputPrefetch
+{
+	const char *         filePath;
+	const CountScaling * scaling;
+	const char * const * selectors;
+	size_t               selectorCount;
+	Buffer               columns[kMaximumPrefetchColumns];
+	InputFileInfo        info;
+	int                  returnValue;
+	int                  isRunning;
+	pthread_t            thread;
+} InputPrefetch;
+
+/**
+ *	@brief Start reading the first channel of a CSV file or binary sample file in the
+ *	background.
+ *	@note If no thread can be created, the file is read before returning.
+ *
+ *	@param prefetch : Pointer to prefetch to start.
+ *	@param filePath : Path to input file (must remain valid until the prefetch is claimed).
+ *	@param scaling  : Pointer to overrides for the scaling of raw integer counts (may be NULL).
+ */
+void
+inputPrefetchStart(
+	InputPrefetch * const      prefetch,
+	const char * const         filePath,
+	const CountScaling * const scaling);
+
+/**
+ *	@brief Start reading selected columns of a multi-column file in the background.
+ *	@note If no thread can be created, the file is read before returning.
+ *
+ *	@param prefetch      : Pointer to prefetch to start.
+ *	@param filePath      : Path to input file (must remain valid until the prefetch is claimed).
+ *	@param selectors     : Array of column selectors, as for readColumnsFromFileToHeapBuffers().
+ *	@param selectorCount : Number of column selectors (at most kMaximumPrefetchColumns).
+ */
+void
+inputPrefetchStartColumns(
+	InputPrefetch * const      prefetch,
+	const char * const         filePath,
+	const char * const * const selectors,
+	const size_t               selectorCount);
+
+/**
+ *	@brief Wait for a prefetch to complete and take ownership of its buffers.
+ *
+ *	@param prefetch : Pointer to started prefetch.
+ *	@param columns  : Array of selectorCount Buffers (one for inputPrefetchStart()) to store the
+ *	values read.
+ *	@param info     : Pointer to location to store file metadata (may be NULL).
+ *	@return int     : 0 if success, 1 if the file could not be read
+ */
+int
+inputPrefetchWait(InputPrefetch * const prefetch, Buffer * const columns, InputFileInfo * const info);
+
+/**
+ *	@brief Wait for a prefetch to complete and free any buffers that were not claimed.
+ *	@note Safe to call on a prefetch that was claimed, or never started if zero initialised.
+ *
+ *	@param prefetch : Pointer to prefetch.
+ */
+void
+inputPrefetchRelease(InputPrefetch * const prefetch);
@@ -23,6 +23,14 @@
  */
 
 #include "integrate.h"
+#include <stddef.h>
+#include <string.h>
+
+typedef struct IntegratorEntry
+{
+	const char *       name;
+	IntegratorFunction function;
+} IntegratorEntry;
 
 void
 integrate(
@@ -41,3 +49,157 @@ integrate(
 		oldState->position + dt / 2.0 * (oldState->speed + intermediateState.speed);
 	newState->speed = oldState->speed + dt / 2.0 * (oldAcceleration + newAcceleration);
 }
+
+/**
+ *	@brief Heun (trapezoidal) timestep, wrapping integrate().
+ */
+static void
+trapezoidStep(
+	State * const       newState,
+	const State * const oldState,
+	const State * const olderState,
+	const float         newAcceleration,
+	const float         oldAcceleration,
+	const float         olderAcceleration,
+	const float         dt)
+{
+	(void)olderState;
+	(void)olderAcceleration;
+
+	integrate(newState, oldState, newAcceleration, oldAcceleration, dt);
+}
+
+/**
+ *	@brief Classic fourth order Runge-Kutta timestep. Acceleration is linearly interpolated
+ *	between the two most recent measurements to obtain the midpoint value.
+ */
+static void
+rungeKutta4Step(
+	State * const       newState,
+	const State * const oldState,
+	const State * const olderState,
+	const float         newAcceleration,
+	const float         oldAcceleration,
+	const float         olderAcceleration,
+	const float         dt)
+{
+	const float midpointAcceleration = (oldAcceleration + newAcceleration) / 2.0;
+
+	(void)olderState;
+	(void)olderAcceleration;
+
+	newState->position = oldState->position + dt * oldState->speed +
+			     dt * dt / 6.0 * (oldAcceleration + 2.0 * midpointAcceleration);
+	newState->speed = oldState->speed + dt / 6.0 *
+						    (oldAcceleration + 4.0 * midpointAcceleration +
+						     newAcceleration);
+}
+
+/**
+ *	@brief Two-step recursive integrator: y[n] = y[n-2] + dt * (a x[n] + b x[n-1] + a x[n-2]),
+ *	applied to obtain speed from acceleration. Position is the trapezoidal integral of speed.
+ *	@note The recursion has a pole at the Nyquist frequency, where its gain is unbounded.
+ *	Applying it twice would square that gain. The trapezoid's zero at the Nyquist frequency
+ *	cancels the pole, so the response from acceleration to position stays bounded.
+ */
+static void
+twoStepRecursiveStep(
+	State * const       newState,
+	const State * const oldState,
+	const State * const olderState,
+	const float         newAcceleration,
+	const float         oldAcceleration,
+	const float         olderAcceleration,
+	const float         dt,
+	const float         outerCoefficient,
+	const float         centreCoefficient)
+{
+	newState->speed = olderState->speed +
+			  dt * (outerCoefficient * (newAcceleration + olderAcceleration) +
+				centreCoefficient * oldAcceleration);
+	newState->position = oldState->position + dt / 2.0 * (oldState->speed + newState->speed);
+}
+
+/**
+ *	@brief Simpson's rule integrator (coefficients 1/3, 4/3, 1/3).
+ */
+static void
+simpsonStep(
+	State * const       newState,
+	const State * const oldState,
+	const State * const olderState,
+	const float         newAcceleration,
+	const float         oldAcceleration,
+	const float         olderAcceleration,
+	const float         dt)
+{
+	twoStepRecursiveStep(
+		newState,
+		oldState,
+		olderState,
+		newAcceleration,
+		oldAcceleration,
+		olderAcceleration,
+		dt,
+		1.0 / 3.0,
+		4.0 / 3.0);
+}
+
+/**
+ *	@brief Tick's integrator (coefficients 0.3584, 1.2832, 0.3584), which has a flatter
+ *	frequency response than Simpson's rule up to around a quarter of the sampling rate.
+ */
+static void
+tickStep(
+	State * const       newState,
+	const State * const oldState,
+	const State * const olderState,
+	const float         newAcceleration,
+	const float         oldAcceleration,
+	const float         olderAcceleration,
+	const float         dt)
+{
+	twoStepRecursiveStep(
+		newState,
+		oldState,
+		olderState,
+		newAcceleration,
+		oldAcceleration,
+		olderAcceleration,
+		dt,
+		0.3584,
+		1.2832);
+}
+
+static const IntegratorEntry integratorTable[kIntegratorMaximum] = {
+	[kIntegratorTrapezoid] = {.name = "trapezoid", .function = trapezoidStep},
+	[kIntegratorSimpson] = {.name = "simpson", .function = simpsonStep},
+	[kIntegratorRungeKutta4] = {.name = "rk4", .function = rungeKutta4Step},
+	[kIntegratorTick] = {.name = "tick", .function = tickStep},
+};
+
+IntegratorFunction
+getIntegrator(const IntegratorType type)
+{
+	if ((size_t)type >= kIntegratorMaximum)
+	{
+		return NULL;
+	}
+
+	return integratorTable[type].function;
+}
+
+int
+parseIntegratorType(const char * const name, IntegratorType * const type)
+{
+	for (size_t i = 0; i < kIntegratorMaximum; i++)
+	{
+		if (strcmp(name, integratorTable[i].name) == 0)
+		{
+			*type = (IntegratorType)i;
+			return 0;
+		}
+	}
+
+	return 1;
+}
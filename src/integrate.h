@@ -30,6 +30,38 @@ typedef struct State
 	float speed;
 } State;
 
+typedef enum
+{
+	kIntegratorTrapezoid,
+	kIntegratorSimpson,
+	kIntegratorRungeKutta4,
+	kIntegratorTick,
+	kIntegratorMaximum,
+} IntegratorType;
+
+/**
+ *	@brief Integration timestep function.
+ *	@note Multi-step schemes (Simpson, Tick) use the two previous states and accelerations to
+ *	obtain speed, and integrate speed to position with the trapezoidal rule so that their gain
+ *	stays bounded at the Nyquist frequency. Single-step schemes ignore the older arguments.
+ *
+ *	@param newState          : Pointer to location to store the current state
+ *	@param oldState          : Pointer to the previous state
+ *	@param olderState        : Pointer to the state before the previous state
+ *	@param newAcceleration   : Measured acceleration for the current timestep
+ *	@param oldAcceleration   : Measured acceleration for the previous timestep
+ *	@param olderAcceleration : Measured acceleration for the timestep before the previous one
+ *	@param dt                : Time period between timesteps
+ */
+typedef void (*IntegratorFunction)(
+	State * const       newState,
+	const State * const oldState,
+	const State * const olderState,
+	const float         newAcceleration,
+	const float         oldAcceleration,
+	const float         olderAcceleration,
+	const float         dt);
+
 /**
  *	@brief Perform numerical integration timestep.
  *
@@ -46,3 +78,23 @@ integrate(
 	const float         newAcceleration,
 	const float         oldAcceleration,
 	const float         dt);
+
+/**
+ *	@brief Look up the timestep function for an integration scheme.
+ *	@note Resolve the function once, outside of any per-sample loop.
+ *
+ *	@param type                : Integration scheme
+ *	@return IntegratorFunction : Timestep function, or NULL if the type is invalid
+ */
+IntegratorFunction
+getIntegrator(const IntegratorType type);
+
+/**
+ *	@brief Parse an integration scheme name.
+ *
+ *	@param name : Scheme name ("trapezoid", "simpson", "rk4" or "tick")
+ *	@param type : Pointer to location to store the parsed scheme
+ *	@return int : 0 if success, 1 if the name is not recognised
+ */
+int
+parseIntegratorType(const char * const name, IntegratorType * const type);
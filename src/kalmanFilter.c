@@ -0,0 +1,118 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "kalmanFilter.h"
+#include <string.h>
+
+void
+kalmanFilterInitialise(
+	KalmanFilter * const                 filter,
+	const KalmanFilterParameters * const parameters)
+{
+	memset(filter, 0, sizeof(*filter));
+
+	filter->parameters = *parameters;
+
+	/*
+	 *	Start at rest with an unknown bias.
+	 */
+	filter->covariance[0][0] = parameters->heaveNoise * parameters->heaveNoise;
+	filter->covariance[1][1] = parameters->heaveNoise * parameters->heaveNoise;
+	filter->covariance[2][2] = parameters->accelerometerNoise * parameters->accelerometerNoise;
+}
+
+float
+kalmanFilterUpdate(KalmanFilter * const filter, const float acceleration)
+{
+	const float dt = filter->parameters.dt;
+	const float halfDtSquared = dt * dt / 2.0;
+	const float correctedAcceleration = acceleration - filter->bias;
+	const float accelerationVariance =
+		filter->parameters.accelerometerNoise * filter->parameters.accelerometerNoise;
+	const float biasVariance = filter->parameters.biasRandomWalk *
+				   filter->parameters.biasRandomWalk * dt;
+	const float F[3][3] = {
+		{1, dt, -halfDtSquared},
+		{0, 1, -dt},
+		{0, 0, 1},
+	};
+	const float G[3] = {halfDtSquared, dt, 0};
+	float       FP[3][3];
+	float       (*P)[3] = filter->covariance;
+	float       innovationVariance;
+	float       innovation;
+	float       gain[3];
+	float       firstRow[3];
+
+	/*
+	 *	Predict: x = F x + G a, P = F P F' + Q.
+	 */
+	filter->state.position += dt * filter->state.speed + halfDtSquared * correctedAcceleration;
+	filter->state.speed += dt * correctedAcceleration;
+
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			FP[i][j] = F[i][0] * P[0][j] + F[i][1] * P[1][j] + F[i][2] * P[2][j];
+		}
+	}
+
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			P[i][j] = FP[i][0] * F[j][0] + FP[i][1] * F[j][1] + FP[i][2] * F[j][2] +
+				  accelerationVariance * G[i] * G[j];
+		}
+	}
+	P[2][2] += biasVariance;
+
+	/*
+	 *	Update with a zero-mean heave pseudo-measurement (H = [1 0 0]), which bounds the
+	 *	drift of the doubly integrated position.
+	 */
+	innovationVariance = P[0][0] + filter->parameters.heaveNoise * filter->parameters.heaveNoise;
+	innovation = -filter->state.position;
+
+	for (int i = 0; i < 3; i++)
+	{
+		gain[i] = P[i][0] / innovationVariance;
+		firstRow[i] = P[0][i];
+	}
+
+	filter->state.position += gain[0] * innovation;
+	filter->state.speed += gain[1] * innovation;
+	filter->bias += gain[2] * innovation;
+
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			P[i][j] -= gain[i] * firstRow[j];
+		}
+	}
+
+	return filter->state.position;
+}
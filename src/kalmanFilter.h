@@ -0,0 +1,77 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "integrate.h"
+
+/**
+ *	@brief Tuning parameters for the Kalman filter heave estimator.
+ *
+ */
+typedef struct KalmanFilterParameters
+{
+	float dt;
+	float accelerometerNoise;
+	float biasRandomWalk;
+	float heaveNoise;
+} KalmanFilterParameters;
+
+/**
+ *	@brief Kalman filter state: heave position and speed, plus the accelerometer bias.
+ *	@note The memory footprint is fixed, so the filter can live on a real-time ingest thread.
+ *
+ */
+typedef struct KalmanFilter
+{
+	State                  state;
+	float                  bias;
+	float                  covariance[3][3];
+	KalmanFilterParameters parameters;
+} KalmanFilter;
+
+/**
+ *	@brief Initialise a Kalman filter heave estimator at rest.
+ *
+ *	@param filter     : Pointer to filter to initialise
+ *	@param parameters : Pointer to filter tuning parameters. The accelerometer noise is the
+ *	standard deviation of each acceleration sample, the bias random walk is the standard
+ *	deviation of the bias drift per second, and the heave noise is the standard deviation of
+ *	heave about its mean (used as a zero-mean pseudo-measurement to suppress drift).
+ */
+void
+kalmanFilterInitialise(
+	KalmanFilter * const                 filter,
+	const KalmanFilterParameters * const parameters);
+
+/**
+ *	@brief Feed one accelerometer sample into the filter.
+ *	@note Constant time and memory per sample.
+ *
+ *	@param filter       : Pointer to filter
+ *	@param acceleration : Measured heave acceleration
+ *	@return float       : Drift-corrected heave displacement estimate
+ */
+float
+kalmanFilterUpdate(KalmanFilter * const filter, const float acceleration);
@@ -22,29 +22,82 @@
  *	SOFTWARE.
  */
 
+#include "directionalSpectrum.h"
+#include "encounterFrequency.h"
+#include "inputPrefetch.h"
+#include "integrate.h"
+#include "kalmanFilter.h"
+#include "outputWriter.h"
+#include "raoCache.h"
+#include "raoLibrary.h"
 #include "signalProcessing.h"
+#include "spectralPartition.h"
+#include "spectrumFit.h"
 #include "uxhw.h"
 #include "utils.h"
 #include "waveEstimation.h"
+#include "waveStatistics.h"
 #include <getopt.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 typedef enum
 {
 	kMaximumPrintLinesInOutput = 9,
+	kMaximumRigColumns = 3,
+	kMaximumOutputSpectra = 4,
+	kDirectionalSegmentSize = 256,
+	kDirectionalOutputColumns = 4,
 } Constants;
 
+static const float kKalmanBiasRandomWalk = 1e-3;
+static const float kDefaultTimestep = 0.1;
+static const float kPartitionTroughRatio = 0.5;
+static const float kPartitionMinimumEnergyFraction = 0.02;
+static const float kDefaultAccelerometerResolution = 0.1;
+
 typedef struct CommandLineArguments
 {
-	char * heaveDisplacementFilePath;
-	float  heaveMeasurementUncertainty;
-	char * waveElevationFilePath;
-	float  waveElevationUncertainty;
-	char * heaveAccelerationFilePath;
-	float  accelerometerResolution;
-	float  timestep;
+	char *                heaveDisplacementFilePath;
+	float                 heaveMeasurementUncertainty;
+	char *                waveElevationFilePath;
+	float                 waveElevationUncertainty;
+	char *                rigFilePath;
+	char *                rigColumnSelectors[kMaximumRigColumns];
+	size_t                rigColumnCount;
+	char *                heaveAccelerationFilePath;
+	float                 accelerometerResolution;
+	CountScaling          accelerometerCountScaling;
+	float                 timestep;
+	float                 testTimestep;
+	IntegratorType        integratorType;
+	float                 kalmanHeaveNoise;
+	WindowType            windowType;
+	char *                outputFilePath;
+	OutputFormat          outputFormat;
+	int                   isFullOutput;
+	char *                cacheDirectoryPath;
+	RAOResamplingType     raoResampling;
+	RAOEstimatorSettings  raoEstimatorSettings;
+	char *                raoLibraryPath;
+	char *                vesselId;
+	char *                loadingCondition;
+	int                   isRAOLibraryUpdate;
+	float                 draft;
+	float                 heading;
+	DeconvolutionSettings deconvolution;
+	int                   isStatisticsOutput;
+	SpectrumModelType     spectrumFitModel;
+	int                   isPartitionOutput;
+	float                 vesselSpeed;
+	float                 waveHeading;
+	char *                buoyFilePath;
+	char *                buoyColumnSelectors[kDirectionalChannelCount];
+	DirectionalMethodType directionalMethod;
+	char *                directionalOutputFilePath;
 } CommandLineArguments;
 
 extern char * optarg;
@@ -65,9 +118,48 @@ printUsage(void)
 	       "	[-D (heave measurement uncertainty)]\n"
 	       "	[-e (path to wave elevation test measurements)]\n"
 	       "	[-E (wave elevation measurement uncertainty)]\n"
+	       "	[-r (path to multi-column file with heave and wave elevation test "
+	       "measurements)]\n"
+	       "	[-c (heave, wave elevation and optional timestamp columns of the -r "
+	       "file)]\n"
 	       "	[-a (path to heave acceleration measurements taken at sea)]\n"
 	       "	[-A (accelerometer resolution)]\n"
+	       "	[-S (scale applied to raw accelerometer counts)]\n"
+	       "	[-O (offset applied to raw accelerometer counts)]\n"
 	       "	[-t (time between successive measurements)]\n"
+	       "	[-g (time between successive test measurements, if different from -t)]\n"
+	       "	[-i (integration scheme: trapezoid, simpson, rk4 or tick)]\n"
+	       "	[-k (use Kalman filter heave estimator with given heave standard "
+	       "deviation)]\n"
+	       "	[-w (window applied to heave displacement: rectangular or hann)]\n"
+	       "	[-o (path to file to write the full wave spectrum to)]\n"
+	       "	[-f (output file format: csv, json or binary)]\n"
+	       "	[-R (also write the RAO and heave spectrum to the output file)]\n"
+	       "	[-C (path to directory to cache characterised RAOs in)]\n"
+	       "	[-I (RAO interpolation onto the acceleration data frequency grid: none, "
+	       "linear or cubic)]\n"
+	       "	[-p (fit a parametric RAO model instead of interpolating the RAO)]\n"
+	       "	[-H (RAO estimator: ratio, h1 or h2)]\n"
+	       "	[-W (Welch segment length for RAO estimation, in samples)]\n"
+	       "	[-Q (minimum coherence of RAO bins used in the wave spectrum)]\n"
+	       "	[-L (path to RAO library file)]\n"
+	       "	[-V (vessel identifier in the RAO library)]\n"
+	       "	[-K (loading condition in the RAO library)]\n"
+	       "	[-X (add the characterised RAO to the RAO library)]\n"
+	       "	[-T (vessel draft in metres)]\n"
+	       "	[-G (vessel heading relative to the waves in degrees)]\n"
+	       "	[-N (RAO deconvolution: exact, floor or tikhonov)]\n"
+	       "	[-l (deconvolution regularisation, 0 for automatic)]\n"
+	       "	[-s (print sea state statistics)]\n"
+	       "	[-F (fit a parametric spectrum: pm, jonswap or ochi-hubble)]\n"
+	       "	[-P (print swell and wind sea partitions of the spectrum)]\n"
+	       "	[-U (vessel speed in m/s, to map encounter to absolute frequency)]\n"
+	       "	[-M (wave heading relative to the vessel in degrees, 180 for head seas)]\n"
+	       "	[-b (path to multi-column file with buoy heave, pitch and roll "
+	       "measurements)]\n"
+	       "	[-B (heave, pitch and roll columns of the -b file)]\n"
+	       "	[-m (directional spreading method: mem or mlm)]\n"
+	       "	[-x (path to file to write the full directional spectrum to)]\n"
 	       "	[-h (display this help message)]\n");
 	printf("\n");
 }
@@ -96,23 +188,33 @@ applyUncertainty(Buffer * const buffer, const float uncertainty)
  *	@brief Characterise RAO from heave displacement and wave elevation measurements.
  *
  *	@param RAOBuffer                           : Pointer to buffer to store RAO characterisation
- *	@param heaveDisplacementFilePath           : Path to file containing heave displacement
- *	measurements
- *	@param waveElevationFilePath               : Path to file containing wave elevation
- *	measurements
+ *	@param coherenceBuffer                     : Pointer to buffer to store the coherence of
+ *	each RAO bin
+ *	@param rigInput                            : Prefetch of the heave displacement, wave
+ *	elevation and (optionally) timestamp columns of a multi-column file, or NULL to use the
+ *	separate files
+ *	@param heaveDisplacementInput              : Prefetch of heave displacement measurements
+ *	@param waveElevationInput                  : Prefetch of wave elevation measurements
  *	@param heaveMeasurementUncertainty         : Uncertainty in heave displacement measurements
  *	@param waveElevationMeasurementUncertainty : Uncertainty in wave elevation measurements
- *	@param measurementPeriod                   : Time period between successive measurements
+ *	@param estimatorSettings                   : Welch RAO estimator settings. The RAO is the
+ *	ratio of whole record power spectra when the defaults (spectral ratio, segment size 0 and
+ *	minimum coherence 0) are given.
+ *	@param measurementPeriod                   : Pointer to time period between successive
+ *	measurements. If 0, it is set from the timestamp column when one is selected.
  *	@return int : 0 if calculation is performed successfully, else 1
  */
 static int
 characteriseRAO(
-	Buffer * const     RAOBuffer,
-	const char * const heaveDisplacementFilePath,
-	const char * const waveElevationFilePath,
-	const float        heaveMeasurementUncertainty,
-	const float        waveElevationMeasurementUncertainty,
-	const float        measurementPeriod)
+	Buffer * const                     RAOBuffer,
+	Buffer * const                     coherenceBuffer,
+	InputPrefetch * const              rigInput,
+	InputPrefetch * const              heaveDisplacementInput,
+	InputPrefetch * const              waveElevationInput,
+	const float                        heaveMeasurementUncertainty,
+	const float                        waveElevationMeasurementUncertainty,
+	const RAOEstimatorSettings * const estimatorSettings,
+	float * const                      measurementPeriod)
 {
 	Buffer heaveDisplacementBuffer = {
 		.heapPointer = NULL,
@@ -133,18 +235,58 @@ characteriseRAO(
 	int    returnValue = 0;
 	size_t spectrumBufferSize;
 
-	if (readFloatsFromFileToHeapBuffer(heaveDisplacementFilePath, &heaveDisplacementBuffer))
+	if (rigInput != NULL)
+	{
+		/*
+		 *	All series are read with one file open and one parse.
+		 */
+		Buffer        rigColumns[kMaximumPrefetchColumns];
+		InputFileInfo rigInfo;
+
+		if (inputPrefetchWait(rigInput, rigColumns, &rigInfo))
+		{
+			printf("Error: could not read test measurements from file: %s\n",
+			       rigInput->filePath);
+			returnValue = 1;
+			goto RETURN;
+		}
+
+		heaveDisplacementBuffer = rigColumns[0];
+		waveElevationBuffer = rigColumns[1];
+
+		if (rigInput->selectorCount > 2)
+		{
+			const double timestampPeriod =
+				calculateMeanTimestep(rigInfo.columnSpans[2], rigColumns[2].size);
+
+			freeHeapBuffer(&rigColumns[2]);
+			if (!(timestampPeriod > 0 && isfinite(timestampPeriod)))
+			{
+				printf("Error: the timestamps in file %s do not give a positive "
+				       "sample period\n",
+				       rigInput->filePath);
+				returnValue = 1;
+				goto RETURN;
+			}
+
+			if (*measurementPeriod == 0)
+			{
+				*measurementPeriod = timestampPeriod;
+			}
+		}
+	}
+	else if (inputPrefetchWait(heaveDisplacementInput, &heaveDisplacementBuffer, NULL))
 	{
 		printf("Error: could not read heave displacement data from file: %s\n",
-		       heaveDisplacementFilePath);
+		       heaveDisplacementInput->filePath);
 		returnValue = 1;
 		goto RETURN;
 	}
 
-	if (readFloatsFromFileToHeapBuffer(waveElevationFilePath, &waveElevationBuffer))
+	else if (inputPrefetchWait(waveElevationInput, &waveElevationBuffer, NULL))
 	{
 		printf("Error: could not read wave elevation data from file: %s\n",
-		       waveElevationFilePath);
+		       waveElevationInput->filePath);
 		returnValue = 1;
 		goto RETURN;
 	}
@@ -161,20 +303,52 @@ characteriseRAO(
 		goto RETURN;
 	}
 
+	applyUncertainty(&heaveDisplacementBuffer, heaveMeasurementUncertainty);
+	applyUncertainty(&waveElevationBuffer, waveElevationMeasurementUncertainty);
+
+	if (estimatorSettings->estimator != kRAOEstimatorSpectralRatio ||
+	    estimatorSettings->segmentSize != 0 || estimatorSettings->minimumCoherence > 0)
+	{
+		RAOEstimatorSettings settings = *estimatorSettings;
+
+		settings.segmentSize = roundUpToNextHighestPowerOfTwo(
+			settings.segmentSize != 0 ? settings.segmentSize
+						  : heaveDisplacementBuffer.size);
+		if (extendHeapBuffer(RAOBuffer, settings.segmentSize) ||
+		    extendHeapBuffer(coherenceBuffer, settings.segmentSize) ||
+		    estimateRAOWelch(
+			    RAOBuffer->heapPointer,
+			    coherenceBuffer->heapPointer,
+			    heaveDisplacementBuffer.heapPointer,
+			    waveElevationBuffer.heapPointer,
+			    heaveDisplacementBuffer.size,
+			    &settings))
+		{
+			returnValue = 1;
+		}
+		goto RETURN;
+	}
+
 	/*
 	 *	Expand frequency domain buffers to an appropriate size.
 	 */
 	spectrumBufferSize = roundUpToNextHighestPowerOfTwo(heaveDisplacementBuffer.size);
 	if (extendHeapBuffer(&heaveSpectrumBuffer, spectrumBufferSize) ||
 	    extendHeapBuffer(&waveSpectrumBuffer, spectrumBufferSize) ||
-	    extendHeapBuffer(RAOBuffer, spectrumBufferSize))
+	    extendHeapBuffer(RAOBuffer, spectrumBufferSize) ||
+	    extendHeapBuffer(coherenceBuffer, spectrumBufferSize))
 	{
 		returnValue = 1;
 		goto RETURN;
 	}
 
-	applyUncertainty(&heaveDisplacementBuffer, heaveMeasurementUncertainty);
-	applyUncertainty(&waveElevationBuffer, waveElevationMeasurementUncertainty);
+	/*
+	 *	The whole record is a single segment, so its coherence is always 1.
+	 */
+	for (size_t i = 0; i < coherenceBuffer->size; i++)
+	{
+		coherenceBuffer->heapPointer[i] = 1;
+	}
 
 	if (calculatePowerSpectrum(
 		    heaveSpectrumBuffer.heapPointer,
@@ -211,247 +385,1729 @@ RETURN:
 }
 
 /**
- *	@brief Estimate wave spectrum from accelerometer measurements and RAO.
+ *	@brief Load the RAO of a vessel in a loading condition from an RAO library.
+ *	@note When both a draft and a heading are given, the RAO is instead interpolated between
+ *	the vessel's entries over draft and heading, and the loading condition is not used.
  *
- *	@param waveSpectrumEstimateBuffer : Buffer to store wave spectrum estimate
- *	@param RAOBuffer                  : Buffer containing RAO for the vessel
- *	@param heaveAccelerationFilePath  : Path to file containing heave acceleration measurements
- *	@param accelerometerResolution    : Measurement resolution for accelerometer data
- *	@param accelerometerTimestep      : Timestep between successive accelerometer measurements
- *	@return int : 0 if calculation is performed successfully, else 1
+ *	@param RAOBuffer         : Pointer to buffer to store RAO characterisation
+ *	@param libraryPath       : Path to RAO library file
+ *	@param vesselId          : Vessel identifier
+ *	@param loadingCondition  : Loading condition
+ *	@param draft             : Vessel draft in metres (NAN if unknown)
+ *	@param heading           : Vessel heading relative to the waves in degrees (NAN if unknown)
+ *	@param measurementPeriod : Pointer to time period between successive measurements. If 0,
+ *	it is set to the period the RAO was characterised with, when the library records it.
+ *	@return int : 0 if success, else 1
  */
 static int
-estimateWaveSpectrum(
-	Buffer * const       waveSpectrumEstimateBuffer,
-	const Buffer * const RAOBuffer,
-	const char * const   heaveAccelerationFilePath,
-	float                accelerometerResolution,
-	float                accelerometerTimestep)
+loadRAOFromLibrary(
+	Buffer * const     RAOBuffer,
+	const char * const libraryPath,
+	const char * const vesselId,
+	const char * const loadingCondition,
+	const float        draft,
+	const float        heading,
+	float * const      measurementPeriod)
 {
-	Buffer oceanHeaveBuffer = {
-		.heapPointer = NULL,
-		.size = 0,
-	};
-	Buffer heaveSpectrumBuffer = {
-		.heapPointer = NULL,
-		.size = 0,
-	};
-	int returnValue = 0;
+	RAOLibrary      library;
+	RAOLibraryEntry entry;
+	RAOBlend        blend;
+	size_t          index;
+	int             returnValue = 0;
 
-	if (readFloatsFromFileToHeapBuffer(heaveAccelerationFilePath, &oceanHeaveBuffer))
+	if (openRAOLibrary(libraryPath, &library))
 	{
-		printf("Error: could not read heave acceleration data from file: %s\n",
-		       heaveAccelerationFilePath);
-		returnValue = 1;
-		goto RETURN;
+		return 1;
 	}
 
-	if (oceanHeaveBuffer.size > SIZE_MAX / 2)
+	if (isfinite(draft) && isfinite(heading))
 	{
-		printf("Error: too many values in the heave acceleration input file.\n"
-		       "Found %zu out of a maximum of %zu\n",
-		       oceanHeaveBuffer.size,
-		       SIZE_MAX / 2);
-		returnValue = 1;
-		goto RETURN;
-	}
-
-	/*
-	 *	Insert measurement uncertainty information.
-	 */
-	applyUncertainty(&oceanHeaveBuffer, accelerometerResolution);
+		if (computeRAOBlend(&library, vesselId, draft, heading, &blend))
+		{
+			returnValue = 1;
+			goto RETURN;
+		}
 
-	/*
-	 *	Integrate acceleration to position.
-	 */
-	numericalIntegration(&oceanHeaveBuffer, accelerometerTimestep);
+		if (blend.binCount == 0 || (blend.binCount & (blend.binCount - 1)) != 0)
+		{
+			printf("Error: the RAOs for vessel '%s' are not a power of two in size\n",
+			       vesselId);
+			returnValue = 1;
+			goto RETURN;
+		}
 
-	if (oceanHeaveBuffer.size < RAOBuffer->size)
-	{
-		/*
-		 *	Zero pad heave buffer
-		 */
-		if (extendHeapBuffer(&oceanHeaveBuffer, RAOBuffer->size))
+		entry.RAO.size = blend.binCount;
+		entry.RAO.heapPointer = (float *)malloc(entry.RAO.size * sizeof(float));
+		if (entry.RAO.heapPointer == NULL)
 		{
+			printf("Error: The program ran out of heap memory. Try reducing the amount "
+			       "of input data, or increasing the amount of available memory by "
+			       "selecting a different core.\n");
 			returnValue = 1;
 			goto RETURN;
 		}
-	}
 
-	/*
-	 *	Extend other buffers to an appropriate size for element-wise arithmetic.
-	 */
-	if (extendHeapBuffer(&heaveSpectrumBuffer, RAOBuffer->size) ||
-	    extendHeapBuffer(waveSpectrumEstimateBuffer, RAOBuffer->size))
+		blendRAOs(&library, &blend, entry.RAO.heapPointer);
+		entry.frequencyStep = blend.frequencyStep;
+	}
+	else if (findRAOLibraryEntry(&library, vesselId, loadingCondition, &index))
 	{
+		printf("Error: no RAO for vessel '%s' in loading condition '%s' in RAO library: "
+		       "%s\n",
+		       vesselId,
+		       loadingCondition,
+		       libraryPath);
 		returnValue = 1;
 		goto RETURN;
 	}
-
-	/*
-	 *	Calculate heave power spectrum from integrated accelerometer data.
-	 */
-	if (calculatePowerSpectrum(
-		    heaveSpectrumBuffer.heapPointer,
-		    oceanHeaveBuffer.heapPointer,
-		    heaveSpectrumBuffer.size))
+	else if (readRAOLibraryEntry(&library, index, &entry, 1))
 	{
-		printf("Error: failed to calculate heave motion power spectrum\n");
+		returnValue = 1;
+		goto RETURN;
+	}
+	else if (entry.RAO.size == 0 || (entry.RAO.size & (entry.RAO.size - 1)) != 0)
+	{
+		printf("Error: the RAO for vessel '%s' in loading condition '%s' is not a power "
+		       "of two in size\n",
+		       vesselId,
+		       loadingCondition);
+		freeHeapBuffer(&entry.RAO);
 		returnValue = 1;
 		goto RETURN;
 	}
 
-	calculateWaveEnergySpectrum(
-		waveSpectrumEstimateBuffer->heapPointer,
-		heaveSpectrumBuffer.heapPointer,
-		RAOBuffer->heapPointer,
-		RAOBuffer->size);
+	*RAOBuffer = entry.RAO;
+	if (*measurementPeriod == 0 && entry.frequencyStep > 0)
+	{
+		*measurementPeriod = 1 / (entry.frequencyStep * entry.RAO.size);
+	}
 
 RETURN:
-	freeHeapBuffer(&oceanHeaveBuffer);
-	freeHeapBuffer(&heaveSpectrumBuffer);
+	closeRAOLibrary(&library);
 	return returnValue;
 }
 
 /**
- *	@brief Get command line arguments.
+ *	@brief Add a characterised RAO to an RAO library.
  *
- *	@param argc      : argument count from main()
- *	@param argv      : argument vector from main()
- *	@param arguments : Pointer to struct to store arguments
- *	@return int : 0 if successful, else 1
+ *	@param RAOBuffer         : Pointer to buffer containing RAO characterisation
+ *	@param libraryPath       : Path to RAO library file
+ *	@param vesselId          : Vessel identifier
+ *	@param loadingCondition  : Loading condition
+ *	@param draft             : Vessel draft in metres (NAN if unknown)
+ *	@param heading           : Vessel heading relative to the waves in degrees (NAN if unknown)
+ *	@param measurementPeriod : Time period between successive measurements (0 if unknown)
+ *	@return int : 0 if success, else 1
  */
 static int
-getCommandLineArguments(int argc, char * argv[], CommandLineArguments * const arguments)
+storeRAOInLibrary(
+	const Buffer * const RAOBuffer,
+	const char * const   libraryPath,
+	const char * const   vesselId,
+	const char * const   loadingCondition,
+	const float          draft,
+	const float          heading,
+	const float          measurementPeriod)
 {
-	int opt;
+	RAOLibraryEntry entry = {
+		.vesselId = {0},
+		.condition = {0},
+		.frequencyStep =
+			measurementPeriod > 0 ? 1 / (measurementPeriod * RAOBuffer->size) : 0,
+		.draft = draft,
+		.heading = heading,
+		.RAO = *RAOBuffer,
+	};
 
-	opterr = 0;
+	strncpy(entry.vesselId, vesselId, sizeof(entry.vesselId) - 1);
+	strncpy(entry.condition, loadingCondition, sizeof(entry.condition) - 1);
 
-	while ((opt = getopt(argc, argv, ":d:D:e:E:a:A:t:h")) != EOF)
+	if (strlen(vesselId) >= sizeof(entry.vesselId) ||
+	    strlen(loadingCondition) >= sizeof(entry.condition))
 	{
-		switch (opt)
+		printf("Error: RAO library vessel identifiers and loading conditions are limited "
+		       "to %zu characters\n",
+		       sizeof(entry.vesselId) - 1);
+		return 1;
+	}
+
+	return addRAOLibraryEntry(libraryPath, &entry);
+}
+
+/**
+ *	@brief Convert raw heave acceleration measurements into zero padded, detrended and windowed
+ *	heave displacement, written directly into the FFT input buffer.
+ *	@note Measurement uncertainty is inserted and acceleration integrated in a single pass
+ *	over the raw data. Mean removal and windowing share a second pass over the FFT input.
+ *	Only the first fftSize samples are packed when the record is longer than the FFT.
+ *
+ *	@param fftInput                : Pointer to zero initialised FFT input buffer
+ *	@param fftSize                 : Number of elements in the FFT input buffer
+ *	@param accelerationBuffer      : Buffer containing raw heave acceleration measurements
+ *	@param accelerometerResolution : Measurement resolution for accelerometer data
+ *	@param dt                      : Timestep between successive accelerometer measurements
+ *	@param integratorType          : Scheme used to integrate acceleration to position
+ *	@param kalmanHeaveNoise        : Heave standard deviation for the Kalman filter heave
+ *	estimator, or 0 to use numerical integration
+ *	@param windowType              : Window function applied to the heave displacement
+ *	@return int : 0 if success, else 1
+ */
+static int
+integrateToFFTInput(
+	Complex * const      fftInput,
+	const size_t         fftSize,
+	const Buffer * const accelerationBuffer,
+	const float          accelerometerResolution,
+	const float          dt,
+	const IntegratorType integratorType,
+	const float          kalmanHeaveNoise,
+	const WindowType     windowType)
+{
+	const size_t packedSize =
+		accelerationBuffer->size < fftSize ? accelerationBuffer->size : fftSize;
+	float total = 0;
+	float mean;
+
+	if (kalmanHeaveNoise > 0)
+	{
+		const KalmanFilterParameters parameters = {
+			.dt = dt,
+			.accelerometerNoise = accelerometerResolution / sqrtf(12.0),
+			.biasRandomWalk = kKalmanBiasRandomWalk,
+			.heaveNoise = kalmanHeaveNoise,
+		};
+		KalmanFilter filter;
+
+		kalmanFilterInitialise(&filter, &parameters);
+
+		for (size_t i = 0; i < accelerationBuffer->size; i++)
 		{
-		case 'd':
-			arguments->heaveDisplacementFilePath = optarg;
-			break;
-		case 'D':
-			arguments->heaveMeasurementUncertainty = atof(optarg);
-			break;
-		case 'e':
-			arguments->waveElevationFilePath = optarg;
-			break;
-		case 'E':
-			arguments->waveElevationUncertainty = atof(optarg);
-			break;
-		case 'a':
-			arguments->heaveAccelerationFilePath = optarg;
-			break;
-		case 'A':
-			arguments->accelerometerResolution = atof(optarg);
-			break;
-		case 't':
-			arguments->timestep = atof(optarg);
-			if (arguments->timestep == 0.0)
+			const float value = accelerationBuffer->heapPointer[i];
+			const float acceleration = UxHwFloatUniformDist(
+				value - accelerometerResolution / 2.0,
+				value + accelerometerResolution / 2.0);
+			const float position = kalmanFilterUpdate(&filter, acceleration);
+
+			total += position;
+			if (i < packedSize)
 			{
-				printf("Error: invalid timestep value: %f\n", arguments->timestep);
-				printUsage();
-				return 1;
+				fftInput[i].real = position;
 			}
-			break;
-		case 'h':
-			printUsage();
-			exit(0);
-		case ':':
-			printf("Error: option -%c is missing a required argument\n", optopt);
-			return 1;
-		case '?':
-			printf("Error: invalid option: -%c\n", optopt);
-			printUsage();
+		}
+	}
+	else
+	{
+		State oldState = {
+			.position = 0,
+			.speed = 0,
+		};
+		State                    olderState = oldState;
+		State                    newState;
+		const IntegratorFunction integrator = getIntegrator(integratorType);
+		float                    oldAcceleration = 0;
+		float olderAcceleration = 0;
+
+		if (integrator == NULL)
+		{
+			printf("Error: invalid integration scheme selected\n");
 			return 1;
 		}
+
+		for (size_t i = 0; i < accelerationBuffer->size; i++)
+		{
+			const float value = accelerationBuffer->heapPointer[i];
+			const float newAcceleration = UxHwFloatUniformDist(
+				value - accelerometerResolution / 2.0,
+				value + accelerometerResolution / 2.0);
+
+			integrator(
+				&newState,
+				&oldState,
+				&olderState,
+				newAcceleration,
+				oldAcceleration,
+				olderAcceleration,
+				dt);
+
+			total += newState.position;
+			if (i < packedSize)
+			{
+				fftInput[i].real = newState.position;
+			}
+
+			olderAcceleration = oldAcceleration;
+			oldAcceleration = newAcceleration;
+			olderState = oldState;
+			oldState = newState;
+		}
+	}
+
+	mean = total / accelerationBuffer->size;
+
+	/*
+	 *	Branch on the window once, so that neither loop dispatches per sample.
+	 */
+	if (windowType == kWindowHann && packedSize > 1)
+	{
+		const double step = 2.0 * acos(-1) / (packedSize - 1);
+
+		for (size_t i = 0; i < packedSize; i++)
+		{
+			fftInput[i].real = (fftInput[i].real - mean) * 0.5 * (1.0 - cosf(step * i));
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < packedSize; i++)
+		{
+			fftInput[i].real -= mean;
+		}
 	}
 
 	return 0;
 }
 
-int
-main(int argc, char * argv[])
+/**
+ *	@brief Map an RAO characteristic onto the frequency grid of a different FFT size, by
+ *	interpolation or by evaluating a parametric model fitted to it.
+ *
+ *	@param RAOBuffer  : Pointer to buffer containing RAO characteristic
+ *	@param fftSize    : FFT size of the new frequency grid
+ *	@param sourceDt   : Time between the successive test measurements the RAO was
+ *	characterised from
+ *	@param dt         : Time between successive measurements of the new frequency grid
+ *	@param resampling : Interpolation scheme or parametric model
+ *	@return int : 0 if success, else 1
+ */
+static int
+resampleRAO(
+	Buffer * const          RAOBuffer,
+	const size_t            fftSize,
+	const float             sourceDt,
+	const float             dt,
+	const RAOResamplingType resampling)
 {
-	Buffer RAOBuffer = {
-		.heapPointer = NULL,
-		.size = 0,
-	};
-	Buffer waveSpectrumEstimateBuffer = {
-		.heapPointer = NULL,
-		.size = 0,
-	};
-	int                  returnValue = 0;
-	CommandLineArguments arguments = {
-		.heaveDisplacementFilePath = "testingHeave.csv",
-		.heaveMeasurementUncertainty = 0.1,
-		.waveElevationFilePath = "testingWaveElevation.csv",
-		.waveElevationUncertainty = 0.1,
-		.heaveAccelerationFilePath = "oceanHeaveAcceleration.csv",
-		.accelerometerResolution = 0.1,
-		.timestep = 0.1,
+	const double sourceFrequencyStep = 1 / ((double)sourceDt * RAOBuffer->size);
+	const double frequencyStep = 1 / ((double)dt * fftSize);
+	Buffer       resampledBuffer = {
+		      .heapPointer = NULL,
+		      .size = 0,
 	};
+	RAOModel model;
 
-	if (getCommandLineArguments(argc, argv, &arguments))
+	if (resampling == kRAOResamplingParametric &&
+	    fitRAOModel(&model, RAOBuffer->heapPointer, RAOBuffer->size, sourceFrequencyStep))
 	{
-		returnValue = 1;
-		goto EXIT_PROGRAM;
+		printf("Error: could not fit a parametric RAO model to the characterised RAO\n");
+		return 1;
 	}
 
-	if (characteriseRAO(
-		    &RAOBuffer,
-		    arguments.heaveDisplacementFilePath,
-		    arguments.waveElevationFilePath,
-		    arguments.heaveMeasurementUncertainty,
-		    arguments.waveElevationUncertainty,
-		    arguments.timestep))
+	if (extendHeapBuffer(&resampledBuffer, fftSize))
 	{
-		returnValue = 1;
-		goto EXIT_PROGRAM;
+		return 1;
 	}
 
-	if (estimateWaveSpectrum(
-		    &waveSpectrumEstimateBuffer,
-		    &RAOBuffer,
-		    arguments.heaveAccelerationFilePath,
-		    arguments.accelerometerResolution,
-		    arguments.timestep))
+	if (resampling == kRAOResamplingParametric)
 	{
-		returnValue = 1;
-		goto EXIT_PROGRAM;
+		evaluateRAOModel(resampledBuffer.heapPointer, &model, fftSize, frequencyStep);
 	}
-
-	if (waveSpectrumEstimateBuffer.heapPointer == NULL)
+	else
 	{
-		returnValue = 1;
-		goto EXIT_PROGRAM;
+		interpolateRAO(
+			resampledBuffer.heapPointer,
+			fftSize,
+			frequencyStep,
+			RAOBuffer->heapPointer,
+			RAOBuffer->size,
+			sourceFrequencyStep,
+			resampling);
 	}
-	else
+
+	freeHeapBuffer(RAOBuffer);
+	*RAOBuffer = resampledBuffer;
+
+	return 0;
+}
+
+/**
+ *	@brief Bring the coherence of the RAO bins onto the frequency grid of the wave spectrum.
+ *	@note The coherence is linearly interpolated as the RAO is. Frequencies the RAO was not
+ *	characterised at get a coherence of 0. When the RAO was loaded from the cache or an RAO
+ *	library, the coherence is not known and every bin is NaN.
+ *
+ *	@param coherenceBuffer : Pointer to buffer containing the coherence of each RAO bin (may be
+ *	empty), to be replaced by the coherence on the new grid.
+ *	@param fftSize         : Size of the FFT of the wave spectrum.
+ *	@param sourceDt        : Time between the test measurements the RAO was characterised from.
+ *	@param dt              : Time between the heave acceleration measurements.
+ *	@return int            : 0 if success, else 1
+ */
+static int
+resampleCoherence(
+	Buffer * const coherenceBuffer,
+	const size_t   fftSize,
+	const float    sourceDt,
+	const float    dt)
+{
+	if (coherenceBuffer->heapPointer == NULL)
 	{
-		const size_t maximumIndex = waveSpectrumEstimateBuffer.size / 2;
-		size_t       arrayInterval = 1;
+		if (extendHeapBuffer(coherenceBuffer, fftSize))
+		{
+			return 1;
+		}
 
-		if (maximumIndex > kMaximumPrintLinesInOutput)
+		for (size_t i = 0; i < fftSize; i++)
 		{
-			arrayInterval = maximumIndex / (kMaximumPrintLinesInOutput - 1);
+			coherenceBuffer->heapPointer[i] = NAN;
 		}
 
-		printf("Wave spectrum: (frequency, wave energy spectral density)\n");
-		for (size_t i = 0; i <= waveSpectrumEstimateBuffer.size / 2; i += arrayInterval)
+		return 0;
+	}
+
+	if (coherenceBuffer->size == fftSize && sourceDt == dt)
+	{
+		return 0;
+	}
+
+	if (resampleRAO(coherenceBuffer, fftSize, sourceDt, dt, kRAOResamplingLinear))
+	{
+		return 1;
+	}
+
+	for (size_t i = 0; i < fftSize; i++)
+	{
+		if (!isfinite(coherenceBuffer->heapPointer[i]))
 		{
-			const float deltaF = 1 / (arguments.timestep * RAOBuffer.size);
-			const float frequency = deltaF * i;
-			printf("%f Hz, %f\n", frequency, waveSpectrumEstimateBuffer.heapPointer[i]);
+			coherenceBuffer->heapPointer[i] = 0;
 		}
 	}
 
-EXIT_PROGRAM:
-	freeHeapBuffer(&RAOBuffer);
-	freeHeapBuffer(&waveSpectrumEstimateBuffer);
+	return 0;
+}
+
+/**
+ *	@brief Estimate wave spectrum from accelerometer measurements and RAO.
+ *
+ *	@param waveSpectrumEstimateBuffer : Buffer to store wave spectrum estimate
+ *	@param RAOBuffer                  : Buffer containing RAO for the vessel. Unless RAO
+ *	resampling is disabled, it is replaced by the RAO on the acceleration data frequency grid.
+ *	@param heaveAccelerationInput     : Prefetch of heave acceleration measurements
+ *	@param accelerometerResolution    : Measurement resolution for accelerometer data. If
+ *	negative, one count for raw count input, or the default resolution otherwise.
+ *	@param accelerometerTimestep      : Pointer to timestep between successive accelerometer
+ *	measurements. If 0, it is set from the input file header, or to the default timestep if
+ *	the input file does not provide one.
+ *	@param testTimestep               : Pointer to timestep between the successive test
+ *	measurements the RAO was characterised from. If 0, it is set to the accelerometer
+ *	timestep.
+ *	@param integratorType             : Scheme used to integrate acceleration to position
+ *	@param kalmanHeaveNoise           : Heave standard deviation for the Kalman filter heave
+ *	estimator, or 0 to use numerical integration
+ *	@param windowType                 : Window function applied to the heave displacement
+ *	@param raoResampling              : How the RAO is mapped onto the frequency grid of the
+ *	acceleration data FFT, or kRAOResamplingNone to size that FFT to the RAO instead
+ *	@param deconvolution              : Pointer to settings of the division of the heave
+ *	spectrum by the RAO
+ *	@param heaveSpectrumOutput        : Pointer to Buffer to store the heave spectrum (may be
+ *	NULL)
+ *	@param densityScale               : Pointer to location to store the factor that converts
+ *	the wave spectrum bins to a one-sided spectral density
+ *	@return int : 0 if calculation is performed successfully, else 1
+ */
+static int
+estimateWaveSpectrum(
+	Buffer * const                      waveSpectrumEstimateBuffer,
+	Buffer * const                      RAOBuffer,
+	InputPrefetch * const               heaveAccelerationInput,
+	float                               accelerometerResolution,
+	float * const                       accelerometerTimestep,
+	float * const                       testTimestep,
+	IntegratorType                      integratorType,
+	float                               kalmanHeaveNoise,
+	WindowType                          windowType,
+	RAOResamplingType                   raoResampling,
+	const DeconvolutionSettings * const deconvolution,
+	Buffer * const                      heaveSpectrumOutput,
+	double * const                      densityScale)
+{
+	Buffer oceanHeaveBuffer = {
+		.heapPointer = NULL,
+		.size = 0,
+	};
+	Buffer heaveSpectrumBuffer = {
+		.heapPointer = NULL,
+		.size = 0,
+	};
+	InputFileInfo oceanHeaveInfo;
+	Complex *     fftInput = NULL;
+	size_t        fftSize;
+	float         regularisation;
+	int           returnValue = 0;
+
+	if (inputPrefetchWait(heaveAccelerationInput, &oceanHeaveBuffer, &oceanHeaveInfo))
+	{
+		printf("Error: could not read heave acceleration data from file: %s\n",
+		       heaveAccelerationInput->filePath);
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	if (accelerometerResolution < 0)
+	{
+		/*
+		 *	Raw counts are resolved to one least significant bit.
+		 */
+		accelerometerResolution = oceanHeaveInfo.isCountData
+						  ? fabsf(oceanHeaveInfo.countScale)
+						  : kDefaultAccelerometerResolution;
+	}
+
+	if (*accelerometerTimestep == 0)
+	{
+		*accelerometerTimestep = oceanHeaveInfo.samplePeriod > 0
+						 ? oceanHeaveInfo.samplePeriod
+						 : kDefaultTimestep;
+	}
+	else if (oceanHeaveInfo.samplePeriod > 0 &&
+		 fabs(oceanHeaveInfo.samplePeriod - *accelerometerTimestep) >
+			 1e-6 * oceanHeaveInfo.samplePeriod)
+	{
+		printf("Warning: timestep %f overrides the sample period %f in file: %s\n",
+		       *accelerometerTimestep,
+		       oceanHeaveInfo.samplePeriod,
+		       heaveAccelerationInput->filePath);
+	}
+
+	if (*testTimestep == 0)
+	{
+		*testTimestep = *accelerometerTimestep;
+	}
+
+	if (oceanHeaveBuffer.size > SIZE_MAX / 2)
+	{
+		printf("Error: too many values in the heave acceleration input file.\n"
+		       "Found %zu out of a maximum of %zu\n",
+		       oceanHeaveBuffer.size,
+		       SIZE_MAX / 2);
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	/*
+	 *	Use the natural FFT size of the acceleration data, and bring the RAO onto its grid.
+	 */
+	fftSize = RAOBuffer->size;
+	if (raoResampling != kRAOResamplingNone)
+	{
+		fftSize = roundUpToNextHighestPowerOfTwo(oceanHeaveBuffer.size);
+		if ((fftSize != RAOBuffer->size || *testTimestep != *accelerometerTimestep ||
+		     raoResampling == kRAOResamplingParametric) &&
+		    resampleRAO(
+			    RAOBuffer,
+			    fftSize,
+			    *testTimestep,
+			    *accelerometerTimestep,
+			    raoResampling))
+		{
+			returnValue = 1;
+			goto RETURN;
+		}
+	}
+	else if (*testTimestep != *accelerometerTimestep)
+	{
+		printf("Error: the test measurements (%f s) and the heave acceleration "
+		       "measurements (%f s) have different sample periods, so the RAO must be "
+		       "interpolated (-I)\n",
+		       *testTimestep,
+		       *accelerometerTimestep);
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	/*
+	 *	Allocate the zero padded FFT input and size other buffers appropriately for
+	 *	element-wise arithmetic.
+	 */
+	fftInput = (Complex *)calloc(fftSize, sizeof(Complex));
+	if (fftInput == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	if (extendHeapBuffer(&heaveSpectrumBuffer, fftSize) ||
+	    extendHeapBuffer(waveSpectrumEstimateBuffer, fftSize))
+	{
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	/*
+	 *	Insert measurement uncertainty information, integrate acceleration to position,
+	 *	detrend and window straight into the FFT input.
+	 */
+	if (integrateToFFTInput(
+		    fftInput,
+		    fftSize,
+		    &oceanHeaveBuffer,
+		    accelerometerResolution,
+		    *accelerometerTimestep,
+		    integratorType,
+		    kalmanHeaveNoise,
+		    windowType))
+	{
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	/*
+	 *	Calculate heave power spectrum from integrated accelerometer data.
+	 */
+	if (calculatePowerSpectrumFromComplex(
+		    heaveSpectrumBuffer.heapPointer,
+		    fftInput,
+		    heaveSpectrumBuffer.size))
+	{
+		printf("Error: failed to calculate heave motion power spectrum\n");
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	if (calculateRegularisedWaveEnergySpectrum(
+		    waveSpectrumEstimateBuffer->heapPointer,
+		    heaveSpectrumBuffer.heapPointer,
+		    RAOBuffer->heapPointer,
+		    fftSize,
+		    deconvolution,
+		    &regularisation))
+	{
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	if (deconvolution->type != kDeconvolutionExact)
+	{
+		printf("Deconvolution regularisation: %e\n", regularisation);
+	}
+
+	/*
+	 *	Squared FFT magnitudes are scaled to a one-sided density allowing for the zero
+	 *	padding and the power the window removes.
+	 */
+	{
+		const size_t packedSize =
+			oceanHeaveBuffer.size < fftSize ? oceanHeaveBuffer.size : fftSize;
+
+		*densityScale = 2 * *accelerometerTimestep /
+				(packedSize * windowPower(windowType, packedSize));
+	}
+
+	if (heaveSpectrumOutput != NULL)
+	{
+		*heaveSpectrumOutput = heaveSpectrumBuffer;
+		heaveSpectrumBuffer.heapPointer = NULL;
+	}
+
+RETURN:
+	free(fftInput);
+	freeHeapBuffer(&oceanHeaveBuffer);
+	freeHeapBuffer(&heaveSpectrumBuffer);
+	return returnValue;
+}
+
+/**
+ *	@brief Map a wave spectrum measured on a moving vessel from encounter frequency onto
+ *	absolute frequency.
+ *
+ *	@param waveSpectrumBuffer : Pointer to buffer containing the wave spectrum (FFT size bins)
+ *	@param mappings           : Pointer to cache of encounter mapping tables
+ *	@param vesselSpeed        : Vessel speed in m/s
+ *	@param waveHeading        : Wave heading relative to the vessel in degrees
+ *	@param timestep           : Time period between successive measurements
+ *	@return int : 0 if success, else 1
+ */
+static int
+mapToAbsoluteFrequency(
+	Buffer * const                waveSpectrumBuffer,
+	EncounterMappingCache * const mappings,
+	const float                   vesselSpeed,
+	const float                   waveHeading,
+	const float                   timestep)
+{
+	const size_t             fftSize = waveSpectrumBuffer->size;
+	const size_t             binCount = fftSize / 2 + 1;
+	const EncounterMapping * mapping;
+	float *                  encounterSpectrum;
+
+	if (lookupEncounterMapping(
+		    mappings,
+		    vesselSpeed,
+		    waveHeading,
+		    binCount,
+		    1 / ((double)timestep * fftSize),
+		    &mapping))
+	{
+		return 1;
+	}
+
+	encounterSpectrum = (float *)malloc(binCount * sizeof(float));
+	if (encounterSpectrum == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		return 1;
+	}
+
+	memcpy(encounterSpectrum, waveSpectrumBuffer->heapPointer, binCount * sizeof(float));
+	applyEncounterMapping(mapping, waveSpectrumBuffer->heapPointer, encounterSpectrum);
+
+	/*
+	 *	Keep the bins above the Nyquist frequency the mirror image of those below it.
+	 */
+	for (size_t i = 1; i < fftSize / 2; i++)
+	{
+		waveSpectrumBuffer->heapPointer[fftSize - i] = waveSpectrumBuffer->heapPointer[i];
+	}
+
+	free(encounterSpectrum);
+
+	return 0;
+}
+
+/**
+ *	@brief Print a summary of the wave spectrum, at most kMaximumPrintLinesInOutput bins.
+ *
+ *	@param waveSpectrumBuffer : Pointer to buffer containing the wave spectrum (FFT size bins)
+ *	@param timestep           : Time period between successive measurements
+ */
+static void
+printWaveSpectrum(const Buffer * const waveSpectrumBuffer, const float timestep)
+{
+	const size_t maximumIndex = waveSpectrumBuffer->size / 2;
+	size_t       arrayInterval = 1;
+
+	if (maximumIndex > kMaximumPrintLinesInOutput)
+	{
+		arrayInterval = maximumIndex / (kMaximumPrintLinesInOutput - 1);
+	}
+
+	printf("Wave spectrum: (frequency, wave energy spectral density)\n");
+	for (size_t i = 0; i <= waveSpectrumBuffer->size / 2; i += arrayInterval)
+	{
+		const float deltaF = 1 / (timestep * waveSpectrumBuffer->size);
+		const float frequency = deltaF * i;
+		printf("%f Hz, %f\n", frequency, waveSpectrumBuffer->heapPointer[i]);
+	}
+}
+
+/**
+ *	@brief Estimate and print the directional wave spectrum from buoy heave, pitch and roll
+ *	measurements.
+ *	@note The spreading function of each frequency bin is estimated independently, so the bins
+ *	are shared out between all online processors. The printed summary is subsampled, so the
+ *	bin with the most energy is printed separately.
+ *
+ *	@param buoyInput      : Pointer to started prefetch of the heave, pitch and roll columns
+ *	@param method         : Directional spreading method
+ *	@param timestep       : Time period between successive measurements, unless the file gives
+ *	one
+ *	@param outputFilePath : Path to file to write every frequency bin to (may be NULL)
+ *	@param outputFormat   : Format of the output file
+ *	@return int : 0 if success, else 1
+ */
+static int
+estimateDirectionalWaveSpectrum(
+	InputPrefetch * const       buoyInput,
+	const DirectionalMethodType method,
+	float                       timestep,
+	const char * const          outputFilePath,
+	const OutputFormat          outputFormat)
+{
+	Buffer                buoyColumns[kMaximumPrefetchColumns];
+	Buffer                outputColumns[kDirectionalOutputColumns] = {{0}};
+	InputFileInfo         buoyInfo;
+	CrossSpectralMatrix * matrices = NULL;
+	DirectionalBin *      bins = NULL;
+	size_t                segmentSize;
+	size_t                binCount;
+	size_t                arrayInterval = 1;
+	size_t                peak = 0;
+	long                  processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+	int                   returnValue = 0;
+
+	if (inputPrefetchWait(buoyInput, buoyColumns, &buoyInfo))
+	{
+		printf("Error: could not read buoy measurements from file: %s\n",
+		       buoyInput->filePath);
+		return 1;
+	}
+
+	if (buoyColumns[0].size < 2)
+	{
+		printf("Error: too few buoy measurements in file: %s\n", buoyInput->filePath);
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	if (buoyInfo.samplePeriod > 0)
+	{
+		timestep = buoyInfo.samplePeriod;
+	}
+
+	segmentSize = roundUpToNextHighestPowerOfTwo(buoyColumns[0].size);
+	if (segmentSize > kDirectionalSegmentSize)
+	{
+		segmentSize = kDirectionalSegmentSize;
+	}
+	binCount = segmentSize / 2 + 1;
+
+	matrices = (CrossSpectralMatrix *)malloc(binCount * sizeof(CrossSpectralMatrix));
+	bins = (DirectionalBin *)malloc(binCount * sizeof(DirectionalBin));
+	if (matrices == NULL || bins == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	if (estimateCrossSpectralMatrix(
+		    matrices,
+		    buoyColumns[0].heapPointer,
+		    buoyColumns[1].heapPointer,
+		    buoyColumns[2].heapPointer,
+		    buoyColumns[0].size,
+		    segmentSize,
+		    timestep))
+	{
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	estimateDirectionalSpectrum(
+		bins,
+		matrices,
+		binCount,
+		method,
+		processorCount > 0 ? (size_t)processorCount : 1);
+
+	if (binCount - 1 > kMaximumPrintLinesInOutput)
+	{
+		arrayInterval = (binCount - 1) / (kMaximumPrintLinesInOutput - 1);
+	}
+
+	printf("Directional spectrum: (frequency, wave energy spectral density, mean direction, "
+	       "directional spread, peak direction)\n");
+	for (size_t i = 0; i < binCount; i += arrayInterval)
+	{
+		printf("%f Hz, %f, %f deg, %f deg, %f deg\n",
+		       i / (timestep * segmentSize),
+		       bins[i].energy,
+		       bins[i].meanDirection,
+		       bins[i].directionalSpread,
+		       bins[i].peakDirection);
+	}
+
+	for (size_t i = 1; i < binCount; i++)
+	{
+		if (bins[i].energy > bins[peak].energy)
+		{
+			peak = i;
+		}
+	}
+
+	printf("Directional spectrum peak: %f Hz, %f, %f deg, %f deg, %f deg\n",
+	       peak / (timestep * segmentSize),
+	       bins[peak].energy,
+	       bins[peak].meanDirection,
+	       bins[peak].directionalSpread,
+	       bins[peak].peakDirection);
+
+	if (outputFilePath != NULL)
+	{
+		const char * const columnNames[kDirectionalOutputColumns] = {
+			"waveEnergySpectrum",
+			"meanDirection",
+			"directionalSpread",
+			"peakDirection",
+		};
+
+		for (size_t j = 0; j < kDirectionalOutputColumns; j++)
+		{
+			if (extendHeapBuffer(&outputColumns[j], binCount))
+			{
+				returnValue = 1;
+				goto RETURN;
+			}
+		}
+
+		for (size_t i = 0; i < binCount; i++)
+		{
+			outputColumns[0].heapPointer[i] = bins[i].energy;
+			outputColumns[1].heapPointer[i] = bins[i].meanDirection;
+			outputColumns[2].heapPointer[i] = bins[i].directionalSpread;
+			outputColumns[3].heapPointer[i] = bins[i].peakDirection;
+		}
+
+		if (writeSpectra(
+			    outputFilePath,
+			    outputFormat,
+			    1 / (timestep * segmentSize),
+			    outputColumns,
+			    columnNames,
+			    kDirectionalOutputColumns))
+		{
+			returnValue = 1;
+			goto RETURN;
+		}
+	}
+
+RETURN:
+	free(matrices);
+	free(bins);
+	for (size_t j = 0; j < kDirectionalOutputColumns; j++)
+	{
+		freeHeapBuffer(&outputColumns[j]);
+	}
+	for (size_t i = 0; i < kDirectionalChannelCount; i++)
+	{
+		freeHeapBuffer(&buoyColumns[i]);
+	}
+	return returnValue;
+}
+
+/**
+ *	@brief Get command line arguments.
+ *
+ *	@param argc      : argument count from main()
+ *	@param argv      : argument vector from main()
+ *	@param arguments : Pointer to struct to store arguments
+ *	@return int : 0 if successful, else 1
+ */
+static int
+getCommandLineArguments(int argc, char * argv[], CommandLineArguments * const arguments)
+{
+	int opt;
+
+	opterr = 0;
+
+	while ((opt = getopt(argc,
+			     argv,
+			     ":d:D:e:E:r:c:a:A:S:O:t:g:i:k:w:o:f:RC:I:p"
+			     "H:W:Q:L:V:K:XT:G:N:l:sF:PU:M:b:B:m:x:h")) != EOF)
+	{
+		switch (opt)
+		{
+		case 'd':
+			arguments->heaveDisplacementFilePath = optarg;
+			break;
+		case 'D':
+			arguments->heaveMeasurementUncertainty = atof(optarg);
+			break;
+		case 'e':
+			arguments->waveElevationFilePath = optarg;
+			break;
+		case 'E':
+			arguments->waveElevationUncertainty = atof(optarg);
+			break;
+		case 'r':
+			arguments->rigFilePath = optarg;
+			break;
+		case 'c':
+			arguments->rigColumnCount = 0;
+			for (char * selector = strtok(optarg, ","); selector != NULL;
+			     selector = strtok(NULL, ","))
+			{
+				if (arguments->rigColumnCount == kMaximumRigColumns)
+				{
+					printf("Error: at most %d columns may be selected\n",
+					       kMaximumRigColumns);
+					return 1;
+				}
+				arguments->rigColumnSelectors[arguments->rigColumnCount] = selector;
+				arguments->rigColumnCount++;
+			}
+			if (arguments->rigColumnCount < 2)
+			{
+				printf("Error: heave and wave elevation columns must be "
+				       "selected\n");
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'a':
+			arguments->heaveAccelerationFilePath = optarg;
+			break;
+		case 'A':
+			arguments->accelerometerResolution = atof(optarg);
+			break;
+		case 'S':
+			arguments->accelerometerCountScaling.scale = atof(optarg);
+			break;
+		case 'O':
+			arguments->accelerometerCountScaling.offset = atof(optarg);
+			break;
+		case 't':
+			arguments->timestep = atof(optarg);
+			if (arguments->timestep == 0.0)
+			{
+				printf("Error: invalid timestep value: %f\n", arguments->timestep);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'g':
+			arguments->testTimestep = atof(optarg);
+			if (!(arguments->testTimestep > 0))
+			{
+				printf("Error: invalid test timestep value: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'i':
+			if (parseIntegratorType(optarg, &arguments->integratorType))
+			{
+				printf("Error: unknown integration scheme: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'k':
+			arguments->kalmanHeaveNoise = atof(optarg);
+			if (arguments->kalmanHeaveNoise <= 0.0)
+			{
+				printf("Error: invalid Kalman filter heave standard deviation: "
+				       "%f\n",
+				       arguments->kalmanHeaveNoise);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'w':
+			if (parseWindowType(optarg, &arguments->windowType))
+			{
+				printf("Error: unknown window function: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'o':
+			arguments->outputFilePath = optarg;
+			break;
+		case 'f':
+			if (parseOutputFormat(optarg, &arguments->outputFormat))
+			{
+				printf("Error: unknown output file format: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'R':
+			arguments->isFullOutput = 1;
+			break;
+		case 'C':
+			arguments->cacheDirectoryPath = optarg;
+			break;
+		case 'I':
+			if (parseRAOInterpolationType(optarg, &arguments->raoResampling))
+			{
+				printf("Error: unknown RAO interpolation scheme: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'p':
+			arguments->raoResampling = kRAOResamplingParametric;
+			break;
+		case 'H':
+			if (parseRAOEstimatorType(
+				    optarg,
+				    &arguments->raoEstimatorSettings.estimator))
+			{
+				printf("Error: unknown RAO estimator: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'W':
+			arguments->raoEstimatorSettings.segmentSize = strtoul(optarg, NULL, 10);
+			if (arguments->raoEstimatorSettings.segmentSize < 2)
+			{
+				printf("Error: invalid Welch segment length: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'Q':
+			arguments->raoEstimatorSettings.minimumCoherence = atof(optarg);
+			if (arguments->raoEstimatorSettings.minimumCoherence < 0 ||
+			    arguments->raoEstimatorSettings.minimumCoherence > 1)
+			{
+				printf("Error: invalid minimum coherence: %f\n",
+				       arguments->raoEstimatorSettings.minimumCoherence);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'L':
+			arguments->raoLibraryPath = optarg;
+			break;
+		case 'V':
+			arguments->vesselId = optarg;
+			break;
+		case 'K':
+			arguments->loadingCondition = optarg;
+			break;
+		case 'X':
+			arguments->isRAOLibraryUpdate = 1;
+			break;
+		case 'T':
+			arguments->draft = atof(optarg);
+			if (!(arguments->draft > 0))
+			{
+				printf("Error: invalid draft: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'N':
+			if (parseDeconvolutionType(optarg, &arguments->deconvolution.type))
+			{
+				printf("Error: unknown deconvolution scheme: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'l':
+			arguments->deconvolution.regularisation = atof(optarg);
+			if (!(arguments->deconvolution.regularisation >= 0))
+			{
+				printf("Error: invalid deconvolution regularisation: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'F':
+			if (parseSpectrumModelType(optarg, &arguments->spectrumFitModel))
+			{
+				printf("Error: unknown spectrum model: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'U':
+			arguments->vesselSpeed = atof(optarg);
+			if (!(arguments->vesselSpeed >= 0))
+			{
+				printf("Error: invalid vessel speed: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'M':
+			arguments->waveHeading = atof(optarg);
+			if (!isfinite(arguments->waveHeading))
+			{
+				printf("Error: invalid wave heading: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'b':
+			arguments->buoyFilePath = optarg;
+			break;
+		case 'B':
+		{
+			size_t columnCount = 0;
+
+			for (char * selector = strtok(optarg, ","); selector != NULL;
+			     selector = strtok(NULL, ","), columnCount++)
+			{
+				if (columnCount < kDirectionalChannelCount)
+				{
+					arguments->buoyColumnSelectors[columnCount] = selector;
+				}
+			}
+			if (columnCount != kDirectionalChannelCount)
+			{
+				printf("Error: heave, pitch and roll columns must be selected\n");
+				printUsage();
+				return 1;
+			}
+			break;
+		}
+		case 'm':
+			if (parseDirectionalMethodType(optarg, &arguments->directionalMethod))
+			{
+				printf("Error: unknown directional spreading method: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'x':
+			arguments->directionalOutputFilePath = optarg;
+			break;
+		case 'P':
+			arguments->isPartitionOutput = 1;
+			break;
+		case 's':
+			arguments->isStatisticsOutput = 1;
+			break;
+		case 'G':
+			arguments->heading = atof(optarg);
+			if (!isfinite(arguments->heading))
+			{
+				printf("Error: invalid heading: %s\n", optarg);
+				printUsage();
+				return 1;
+			}
+			break;
+		case 'h':
+			printUsage();
+			exit(0);
+		case ':':
+			printf("Error: option -%c is missing a required argument\n", optopt);
+			return 1;
+		case '?':
+			printf("Error: invalid option: -%c\n", optopt);
+			printUsage();
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int
+main(int argc, char * argv[])
+{
+	Buffer RAOBuffer = {
+		.heapPointer = NULL,
+		.size = 0,
+	};
+	Buffer waveSpectrumEstimateBuffer = {
+		.heapPointer = NULL,
+		.size = 0,
+	};
+	Buffer heaveSpectrumBuffer = {
+		.heapPointer = NULL,
+		.size = 0,
+	};
+	Buffer coherenceBuffer = {
+		.heapPointer = NULL,
+		.size = 0,
+	};
+	InputPrefetch         rigInput = {0};
+	InputPrefetch         heaveDisplacementInput = {0};
+	InputPrefetch         waveElevationInput = {0};
+	InputPrefetch         heaveAccelerationInput = {0};
+	InputPrefetch         buoyInput = {0};
+	double                densityScale = 0;
+	EncounterMappingCache encounterMappings = {0};
+	uint64_t              RAOCacheKey = 0;
+	int                   isRAOCacheable = 0;
+	int                   isRAOLoaded = 0;
+	int                   returnValue = 0;
+	CommandLineArguments  arguments = {
+		.heaveDisplacementFilePath = "testingHeave.csv",
+		.heaveMeasurementUncertainty = 0.1,
+		.waveElevationFilePath = "testingWaveElevation.csv",
+		.waveElevationUncertainty = 0.1,
+		.rigFilePath = NULL,
+		.rigColumnSelectors = {"heave", "elevation"},
+		.rigColumnCount = 2,
+		.heaveAccelerationFilePath = "oceanHeaveAcceleration.csv",
+		.accelerometerResolution = -1,
+		.accelerometerCountScaling = {
+			.scale = NAN,
+			.offset = NAN,
+		},
+		.timestep = 0,
+		.testTimestep = 0,
+		.integratorType = kIntegratorTrapezoid,
+		.kalmanHeaveNoise = 0,
+		.windowType = kWindowRectangular,
+		.outputFilePath = NULL,
+		.outputFormat = kOutputFormatCSV,
+		.isFullOutput = 0,
+		.cacheDirectoryPath = NULL,
+		.raoResampling = kRAOResamplingLinear,
+		.raoEstimatorSettings = {
+			.estimator = kRAOEstimatorSpectralRatio,
+			.segmentSize = 0,
+			.minimumCoherence = 0,
+		},
+		.raoLibraryPath = NULL,
+		.vesselId = NULL,
+		.loadingCondition = "default",
+		.isRAOLibraryUpdate = 0,
+		.draft = NAN,
+		.heading = NAN,
+		.deconvolution = {
+			.type = kDeconvolutionExact,
+			.regularisation = 0,
+		},
+		.isStatisticsOutput = 0,
+		.spectrumFitModel = kSpectrumModelMaximum,
+		.isPartitionOutput = 0,
+		.vesselSpeed = NAN,
+		.waveHeading = NAN,
+		.buoyFilePath = NULL,
+		.buoyColumnSelectors = {"heave", "pitch", "roll"},
+		.directionalMethod = kDirectionalMethodMEM,
+		.directionalOutputFilePath = NULL,
+	};
+
+	if (getCommandLineArguments(argc, argv, &arguments))
+	{
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	if ((arguments.raoLibraryPath == NULL) != (arguments.vesselId == NULL))
+	{
+		printf("Error: an RAO library (-L) and a vessel identifier (-V) must be given "
+		       "together\n");
+		printUsage();
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	if (arguments.isRAOLibraryUpdate && arguments.raoLibraryPath == NULL)
+	{
+		printf("Error: adding an RAO to the library (-X) needs an RAO library (-L) and a "
+		       "vessel identifier (-V)\n");
+		printUsage();
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	if (arguments.raoLibraryPath == NULL &&
+	    (isfinite(arguments.draft) || isfinite(arguments.heading) ||
+	     strcmp(arguments.loadingCondition, "default") != 0))
+	{
+		printf("Error: a loading condition (-K), draft (-T) or heading (-G) needs an RAO "
+		       "library (-L)\n");
+		printUsage();
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	if (isfinite(arguments.draft) != isfinite(arguments.heading))
+	{
+		printf("Error: a draft (-T) and a heading (-G) must be given together\n");
+		printUsage();
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	/*
+	 *	Library entries are keyed by vessel and loading condition only, so every draft and
+	 *	heading of the grid needs a loading condition of its own.
+	 */
+	if (arguments.isRAOLibraryUpdate && isfinite(arguments.draft) &&
+	    strcmp(arguments.loadingCondition, "default") == 0)
+	{
+		printf("Error: a loading condition (-K) other than 'default' must name the "
+		       "draft (-T) and heading (-G) of an RAO added to the library\n");
+		printUsage();
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	if (isfinite(arguments.vesselSpeed) != isfinite(arguments.waveHeading))
+	{
+		printf("Error: a vessel speed (-U) and a wave heading (-M) must be given "
+		       "together\n");
+		printUsage();
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	if (arguments.directionalOutputFilePath != NULL && arguments.buoyFilePath == NULL)
+	{
+		printf("Error: the directional spectrum output (-x) needs a buoy file (-b)\n");
+		printUsage();
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	/*
+	 *	Only the wave spectrum is mapped onto absolute frequency. The RAO and heave spectrum
+	 *	stay over encounter frequency, so they cannot share its frequency column.
+	 */
+	if (isfinite(arguments.vesselSpeed) && arguments.isFullOutput)
+	{
+		printf("Error: the RAO and heave spectrum output (-R) is over encounter "
+		       "frequency, so it cannot be used with a vessel speed (-U)\n");
+		printUsage();
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	/*
+	 *	A timestep given with -t applies to the test measurements too, unless -g is given.
+	 */
+	if (arguments.testTimestep == 0)
+	{
+		arguments.testTimestep = arguments.timestep;
+	}
+
+	/*
+	 *	Read the (typically much larger) acceleration record in the background while the RAO
+	 *	is loaded from the cache or characterised.
+	 */
+	inputPrefetchStart(
+		&heaveAccelerationInput,
+		arguments.heaveAccelerationFilePath,
+		&arguments.accelerometerCountScaling);
+
+	if (arguments.buoyFilePath != NULL)
+	{
+		inputPrefetchStartColumns(
+			&buoyInput,
+			arguments.buoyFilePath,
+			(const char * const *)arguments.buoyColumnSelectors,
+			kDirectionalChannelCount);
+	}
+
+	if (arguments.raoLibraryPath != NULL && !arguments.isRAOLibraryUpdate)
+	{
+		if (loadRAOFromLibrary(
+			    &RAOBuffer,
+			    arguments.raoLibraryPath,
+			    arguments.vesselId,
+			    arguments.loadingCondition,
+			    arguments.draft,
+			    arguments.heading,
+			    &arguments.testTimestep))
+		{
+			returnValue = 1;
+			goto EXIT_PROGRAM;
+		}
+		isRAOLoaded = 1;
+	}
+	else if (arguments.cacheDirectoryPath != NULL &&
+		 (arguments.heaveMeasurementUncertainty != 0 ||
+		  arguments.waveElevationUncertainty != 0))
+	{
+		/*
+		 *	The cache holds point values, but on processors that track uncertainty an
+		 *	RAO characterised from uncertain measurements is a distribution.
+		 *	Characterise it every time so that results do not depend on the state of the
+		 *	cache.
+		 */
+		printf("Warning: the RAO cache is only used when the measurement uncertainties (-D "
+		       "and -E) are zero\n");
+	}
+	else if (arguments.cacheDirectoryPath != NULL)
+	{
+		const char * const separateFilePaths[] = {
+			arguments.heaveDisplacementFilePath,
+			arguments.waveElevationFilePath,
+		};
+		const float parameters[] = {
+			arguments.testTimestep,
+			arguments.raoEstimatorSettings.estimator,
+			arguments.raoEstimatorSettings.segmentSize,
+			arguments.raoEstimatorSettings.minimumCoherence,
+		};
+		const int isRig = (arguments.rigFilePath != NULL);
+
+		isRAOCacheable =
+			raoCacheKey(isRig ? (const char * const *)&arguments.rigFilePath
+					  : separateFilePaths,
+				    isRig ? 1 : 2,
+				    (const char * const *)arguments.rigColumnSelectors,
+				    isRig ? arguments.rigColumnCount : 0,
+				    parameters,
+				    sizeof(parameters) / sizeof(parameters[0]),
+				    &RAOCacheKey) == 0;
+
+		if (isRAOCacheable)
+		{
+			isRAOLoaded = raoCacheLoad(
+					      arguments.cacheDirectoryPath,
+					      RAOCacheKey,
+					      &RAOBuffer,
+					      &arguments.testTimestep) == 0;
+		}
+	}
+
+	if (!isRAOLoaded)
+	{
+		if (arguments.rigFilePath != NULL)
+		{
+			inputPrefetchStartColumns(
+				&rigInput,
+				arguments.rigFilePath,
+				(const char * const *)arguments.rigColumnSelectors,
+				arguments.rigColumnCount);
+		}
+		else
+		{
+			inputPrefetchStart(
+				&heaveDisplacementInput,
+				arguments.heaveDisplacementFilePath,
+				NULL);
+			inputPrefetchStart(
+				&waveElevationInput,
+				arguments.waveElevationFilePath,
+				NULL);
+		}
+
+		if (characteriseRAO(
+			    &RAOBuffer,
+			    &coherenceBuffer,
+			    arguments.rigFilePath != NULL ? &rigInput : NULL,
+			    &heaveDisplacementInput,
+			    &waveElevationInput,
+			    arguments.heaveMeasurementUncertainty,
+			    arguments.waveElevationUncertainty,
+			    &arguments.raoEstimatorSettings,
+			    &arguments.testTimestep))
+		{
+			returnValue = 1;
+			goto EXIT_PROGRAM;
+		}
+
+		/*
+		 *	A failure to cache the RAO does not affect this run.
+		 */
+		if (isRAOCacheable)
+		{
+			raoCacheStore(
+				arguments.cacheDirectoryPath,
+				RAOCacheKey,
+				&RAOBuffer,
+				arguments.testTimestep);
+		}
+	}
+
+	/*
+	 *	An RAO loaded from the cache is stored in the library too.
+	 */
+	if (arguments.isRAOLibraryUpdate &&
+	    storeRAOInLibrary(
+		    &RAOBuffer,
+		    arguments.raoLibraryPath,
+		    arguments.vesselId,
+		    arguments.loadingCondition,
+		    arguments.draft,
+		    arguments.heading,
+		    arguments.testTimestep))
+	{
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	if (estimateWaveSpectrum(
+		    &waveSpectrumEstimateBuffer,
+		    &RAOBuffer,
+		    &heaveAccelerationInput,
+		    arguments.accelerometerResolution,
+		    &arguments.timestep,
+		    &arguments.testTimestep,
+		    arguments.integratorType,
+		    arguments.kalmanHeaveNoise,
+		    arguments.windowType,
+		    arguments.raoResampling,
+		    &arguments.deconvolution,
+		    &heaveSpectrumBuffer,
+		    &densityScale))
+	{
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	if (waveSpectrumEstimateBuffer.heapPointer == NULL)
+	{
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	if (isfinite(arguments.vesselSpeed) &&
+	    mapToAbsoluteFrequency(
+		    &waveSpectrumEstimateBuffer,
+		    &encounterMappings,
+		    arguments.vesselSpeed,
+		    arguments.waveHeading,
+		    arguments.timestep))
+	{
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	printWaveSpectrum(&waveSpectrumEstimateBuffer, arguments.timestep);
+
+	if (arguments.isStatisticsOutput)
+	{
+		WaveStatistics waveStatistics;
+
+		calculateWaveStatistics(
+			&waveStatistics,
+			waveSpectrumEstimateBuffer.heapPointer,
+			waveSpectrumEstimateBuffer.size / 2,
+			1 / (arguments.timestep * waveSpectrumEstimateBuffer.size),
+			densityScale);
+
+		printf("Sea state:\n");
+		printf("Significant wave height (Hs): %f\n", waveStatistics.significantWaveHeight);
+		printf("Peak period (Tp): %f s\n", waveStatistics.peakPeriod);
+		printf("Mean period (Tm01): %f s\n", waveStatistics.meanPeriod);
+		printf("Zero crossing period (Tz): %f s\n", waveStatistics.zeroCrossingPeriod);
+		printf("Energy period (Te): %f s\n", waveStatistics.energyPeriod);
+		printf("Spectral bandwidth: %f\n", waveStatistics.spectralBandwidth);
+	}
+
+	if (arguments.isPartitionOutput)
+	{
+		const SpectralPartitionSettings settings = {
+			.troughRatio = kPartitionTroughRatio,
+			.minimumEnergyFraction = kPartitionMinimumEnergyFraction,
+		};
+		const double frequencyStep =
+			1 / (arguments.timestep * waveSpectrumEstimateBuffer.size);
+		SpectralPartition partitions[kMaximumSpectralPartitions];
+		size_t            partitionCount;
+
+		partitionCount = partitionWaveSpectrum(
+			partitions,
+			waveSpectrumEstimateBuffer.heapPointer,
+			waveSpectrumEstimateBuffer.size / 2,
+			frequencyStep,
+			densityScale,
+			&settings);
+
+		printf("Spectral partitions: (frequency range, Hs, Tp, energy)\n");
+		for (size_t i = 0; i < partitionCount; i++)
+		{
+			printf("%f-%f Hz, %f, %f s, %e\n",
+			       partitions[i].firstBin * frequencyStep,
+			       partitions[i].lastBin * frequencyStep,
+			       partitions[i].significantWaveHeight,
+			       partitions[i].peakPeriod,
+			       partitions[i].energy * densityScale * frequencyStep);
+		}
+	}
+
+	if (arguments.spectrumFitModel != kSpectrumModelMaximum)
+	{
+		SpectrumFit fit;
+
+		if (fitWaveSpectrum(
+			    &fit,
+			    arguments.spectrumFitModel,
+			    waveSpectrumEstimateBuffer.heapPointer,
+			    waveSpectrumEstimateBuffer.size / 2,
+			    1 / (arguments.timestep * waveSpectrumEstimateBuffer.size),
+			    densityScale))
+		{
+			printf("Error: too few usable wave spectrum bins to fit a %s spectrum\n",
+			       spectrumModelName(arguments.spectrumFitModel));
+			returnValue = 1;
+			goto EXIT_PROGRAM;
+		}
+
+		printf("Spectrum fit (%s): RMS residual %e after %zu iterations%s\n",
+		       spectrumModelName(fit.model),
+		       fit.residual,
+		       fit.iterations,
+		       fit.isConverged ? "" : " (not converged)");
+		for (size_t i = 0; i < spectrumModelParameterCount(fit.model); i++)
+		{
+			printf("%s: %f\n",
+			       spectrumModelParameterName(fit.model, i),
+			       fit.parameters[i]);
+		}
+	}
+
+	if (arguments.buoyFilePath != NULL &&
+	    estimateDirectionalWaveSpectrum(
+		    &buoyInput,
+		    arguments.directionalMethod,
+		    arguments.timestep,
+		    arguments.directionalOutputFilePath,
+		    arguments.outputFormat))
+	{
+		returnValue = 1;
+		goto EXIT_PROGRAM;
+	}
+
+	if (arguments.outputFilePath != NULL)
+	{
+		/*
+		 *	Write every bin up to the Nyquist frequency.
+		 */
+		const size_t binCount = waveSpectrumEstimateBuffer.size / 2 + 1;
+		Buffer       spectra[kMaximumOutputSpectra] = {
+			{
+				.heapPointer = waveSpectrumEstimateBuffer.heapPointer,
+				.size = binCount,
+			},
+			{
+				.heapPointer = RAOBuffer.heapPointer,
+				.size = binCount,
+			},
+			{
+				.heapPointer = heaveSpectrumBuffer.heapPointer,
+				.size = binCount,
+			},
+			{
+				.heapPointer = NULL,
+				.size = binCount,
+			},
+		};
+		const char * const spectrumNames[kMaximumOutputSpectra] = {
+			"waveEnergySpectrum",
+			"rao",
+			"heaveSpectrum",
+			"coherence",
+		};
+
+		if (arguments.isFullOutput)
+		{
+			if (resampleCoherence(
+				    &coherenceBuffer,
+				    waveSpectrumEstimateBuffer.size,
+				    arguments.testTimestep,
+				    arguments.timestep))
+			{
+				returnValue = 1;
+				goto EXIT_PROGRAM;
+			}
+			spectra[3].heapPointer = coherenceBuffer.heapPointer;
+		}
+
+		if (writeSpectra(
+			    arguments.outputFilePath,
+			    arguments.outputFormat,
+			    1 / (arguments.timestep * waveSpectrumEstimateBuffer.size),
+			    spectra,
+			    spectrumNames,
+			    arguments.isFullOutput ? kMaximumOutputSpectra : 1))
+		{
+			returnValue = 1;
+			goto EXIT_PROGRAM;
+		}
+	}
+
+EXIT_PROGRAM:
+	inputPrefetchRelease(&rigInput);
+	inputPrefetchRelease(&heaveDisplacementInput);
+	inputPrefetchRelease(&waveElevationInput);
+	inputPrefetchRelease(&heaveAccelerationInput);
+	inputPrefetchRelease(&buoyInput);
+	freeHeapBuffer(&RAOBuffer);
+	freeHeapBuffer(&waveSpectrumEstimateBuffer);
+	freeHeapBuffer(&heaveSpectrumBuffer);
+	freeHeapBuffer(&coherenceBuffer);
+	freeEncounterMappingCache(&encounterMappings);
 	return returnValue;
 }
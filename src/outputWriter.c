@@ -0,0 +1,433 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "outputWriter.h"
+#include "sampleFile.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum
+{
+	kOutputBufferSize = 1 << 20,
+	kMaximumFieldLength = 32,
+	kSignificantDigits = 9,
+	kMinimumDecimalExponent = -46,
+	kMaximumDecimalExponent = 53,
+} OutputWriterConstants;
+
+/*
+ *	Powers of ten from 1e-46 to 1e53: the decimal exponents of all finite non-zero floats, and
+ *	the factors that scale them to kSignificantDigits integer digits.
+ */
+static const double kPowersOfTen[] = {
+	1e-46, 1e-45, 1e-44, 1e-43, 1e-42, 1e-41, 1e-40, 1e-39,
+	1e-38, 1e-37, 1e-36, 1e-35, 1e-34, 1e-33, 1e-32, 1e-31,
+	1e-30, 1e-29, 1e-28, 1e-27, 1e-26, 1e-25, 1e-24, 1e-23,
+	1e-22, 1e-21, 1e-20, 1e-19, 1e-18, 1e-17, 1e-16, 1e-15,
+	1e-14, 1e-13, 1e-12, 1e-11, 1e-10, 1e-9, 1e-8, 1e-7,
+	1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1e0, 1e1,
+	1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+	1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+	1e18, 1e19, 1e20, 1e21, 1e22, 1e23, 1e24, 1e25,
+	1e26, 1e27, 1e28, 1e29, 1e30, 1e31, 1e32, 1e33,
+	1e34, 1e35, 1e36, 1e37, 1e38, 1e39, 1e40, 1e41,
+	1e42, 1e43, 1e44, 1e45, 1e46, 1e47, 1e48, 1e49,
+	1e50, 1e51, 1e52, 1e53,
+};
+
+/**
+ *	@brief Output file with a large write buffer.
+ *
+ */
+typedef struct OutputStream
+{
+	FILE * stream;
+	char * buffer;
+	size_t used;
+	int    hasError;
+} OutputStream;
+
+static double
+powerOfTen(const int exponent)
+{
+	if (exponent < kMinimumDecimalExponent)
+	{
+		return 0;
+	}
+
+	if (exponent > kMaximumDecimalExponent)
+	{
+		return INFINITY;
+	}
+
+	return kPowersOfTen[exponent - kMinimumDecimalExponent];
+}
+
+/**
+ *	@brief Format a float in scientific notation with nine significant digits (enough to
+ *	read the value back exactly), omitting trailing zeros.
+ *
+ *	@param output  : Pointer to at least kMaximumFieldLength characters.
+ *	@param value   : Value to format.
+ *	@param isJSON  : Non-zero to write non-finite values as JSON null.
+ *	@return size_t : Number of characters written
+ */
+static size_t
+formatFloat(char * const output, const float value, const int isJSON)
+{
+	char *   p = output;
+	double   magnitude = fabs((double)value);
+	int      exponent;
+	int      binaryExponent;
+	uint32_t digits;
+	char     mantissa[kSignificantDigits];
+	int      digitCount = kSignificantDigits;
+
+	if (!isfinite(value))
+	{
+		const char * text = "inf";
+
+		if (isJSON)
+		{
+			text = "null";
+		}
+		else if (isnan(value))
+		{
+			text = "nan";
+		}
+		else if (value < 0)
+		{
+			text = "-inf";
+		}
+
+		const size_t length = strlen(text);
+
+		memcpy(output, text, length);
+		return length;
+	}
+
+	if (signbit(value))
+	{
+		*p++ = '-';
+	}
+
+	if (magnitude == 0)
+	{
+		*p++ = '0';
+		return p - output;
+	}
+
+	/*
+	 *	Estimate the decimal exponent from the binary exponent, then correct it by at most one.
+	 */
+	frexp(magnitude, &binaryExponent);
+	exponent = (int)floor((binaryExponent - 1) * 0.30102999566398120);
+	if (magnitude >= powerOfTen(exponent + 1))
+	{
+		exponent++;
+	}
+	else if (magnitude < powerOfTen(exponent))
+	{
+		exponent--;
+	}
+
+	digits = (uint32_t)(magnitude * powerOfTen(kSignificantDigits - 1 - exponent) + 0.5);
+	if (digits >= 1000000000u)
+	{
+		digits /= 10;
+		exponent++;
+	}
+
+	for (int i = kSignificantDigits - 1; i >= 0; i--)
+	{
+		mantissa[i] = (char)('0' + digits % 10);
+		digits /= 10;
+	}
+
+	while (digitCount > 1 && mantissa[digitCount - 1] == '0')
+	{
+		digitCount--;
+	}
+
+	*p++ = mantissa[0];
+	if (digitCount > 1)
+	{
+		*p++ = '.';
+		memcpy(p, mantissa + 1, digitCount - 1);
+		p += digitCount - 1;
+	}
+
+	*p++ = 'e';
+	*p++ = exponent < 0 ? '-' : '+';
+	exponent = abs(exponent);
+	*p++ = (char)('0' + exponent / 10);
+	*p++ = (char)('0' + exponent % 10);
+
+	return p - output;
+}
+
+/**
+ *	@brief Write out the buffered characters.
+ */
+static void
+flushOutput(OutputStream * const output)
+{
+	if (output->used > 0 && fwrite(output->buffer, 1, output->used, output->stream) != output->used)
+	{
+		output->hasError = 1;
+	}
+
+	output->used = 0;
+}
+
+/**
+ *	@brief Make room for at least length characters in the write buffer.
+ *
+ *	@return char * : Pointer to the free space
+ */
+static char *
+reserveOutput(OutputStream * const output, const size_t length)
+{
+	if (output->used + length > kOutputBufferSize)
+	{
+		flushOutput(output);
+	}
+
+	return output->buffer + output->used;
+}
+
+static void
+writeText(OutputStream * const output, const char * const text)
+{
+	const size_t length = strlen(text);
+
+	if (length > kOutputBufferSize)
+	{
+		flushOutput(output);
+		if (fwrite(text, 1, length, output->stream) != length)
+		{
+			output->hasError = 1;
+		}
+		return;
+	}
+
+	memcpy(reserveOutput(output, length), text, length);
+	output->used += length;
+}
+
+static void
+writeCharacter(OutputStream * const output, const char character)
+{
+	*reserveOutput(output, 1) = character;
+	output->used++;
+}
+
+static void
+writeFloat(OutputStream * const output, const float value, const int isJSON)
+{
+	output->used += formatFloat(reserveOutput(output, kMaximumFieldLength), value, isJSON);
+}
+
+/**
+ *	@brief Write spectra as CSV: a header line, then the frequency and spectra of each bin.
+ */
+static void
+writeSpectraCSV(
+	OutputStream * const       output,
+	const float                frequencyStep,
+	const Buffer * const       spectra,
+	const char * const * const names,
+	const size_t               spectrumCount)
+{
+	writeText(output, "frequency");
+	for (size_t j = 0; j < spectrumCount; j++)
+	{
+		writeText(output, ",");
+		writeText(output, names[j]);
+	}
+	writeText(output, "\n");
+
+	for (size_t i = 0; i < spectra[0].size; i++)
+	{
+		writeFloat(output, frequencyStep * i, 0);
+		for (size_t j = 0; j < spectrumCount; j++)
+		{
+			writeCharacter(output, ',');
+			writeFloat(output, spectra[j].heapPointer[i], 0);
+		}
+		writeCharacter(output, '\n');
+	}
+}
+
+/**
+ *	@brief Write a JSON array member with one value per bin.
+ */
+static void
+writeArrayJSON(
+	OutputStream * const output,
+	const char * const   name,
+	const float * const  values,
+	const float          frequencyStep,
+	const size_t         size)
+{
+	writeText(output, ",\n\t\"");
+	writeText(output, name);
+	writeText(output, "\": [");
+	for (size_t i = 0; i < size; i++)
+	{
+		if (i > 0)
+		{
+			writeCharacter(output, ',');
+		}
+		writeFloat(output, values != NULL ? values[i] : frequencyStep * i, 1);
+	}
+	writeText(output, "]");
+}
+
+/**
+ *	@brief Write spectra as a JSON object holding the frequency resolution, and an array of
+ *	bin frequencies and of each spectrum.
+ */
+static void
+writeSpectraJSON(
+	OutputStream * const       output,
+	const float                frequencyStep,
+	const Buffer * const       spectra,
+	const char * const * const names,
+	const size_t               spectrumCount)
+{
+	writeText(output, "{\n\t\"frequencyStep\": ");
+	writeFloat(output, frequencyStep, 1);
+	writeArrayJSON(output, "frequency", NULL, frequencyStep, spectra[0].size);
+	for (size_t j = 0; j < spectrumCount; j++)
+	{
+		writeArrayJSON(output, names[j], spectra[j].heapPointer, 0, spectra[j].size);
+	}
+	writeText(output, "\n}\n");
+}
+
+int
+writeSpectra(
+	const char * const         filePath,
+	const OutputFormat         format,
+	const float                frequencyStep,
+	const Buffer * const       spectra,
+	const char * const * const names,
+	const size_t               spectrumCount)
+{
+	OutputStream output = {
+		.stream = NULL,
+		.buffer = NULL,
+		.used = 0,
+		.hasError = 0,
+	};
+
+	if (spectrumCount == 0)
+	{
+		printf("Error: no spectra to write to file at path '%s'\n", filePath);
+		return 1;
+	}
+
+	for (size_t j = 1; j < spectrumCount; j++)
+	{
+		if (spectra[j].size != spectra[0].size)
+		{
+			printf("Error: all spectra written to a file must have the same length\n");
+			return 1;
+		}
+	}
+
+	if (format == kOutputFormatBinary)
+	{
+		return writeSampleFile(filePath, spectra, names, spectrumCount, frequencyStep);
+	}
+
+	output.buffer = (char *)malloc(kOutputBufferSize);
+	if (output.buffer == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		return 1;
+	}
+
+	output.stream = fopen(filePath, "w");
+	if (output.stream == NULL)
+	{
+		printf("Error: could not open file at path '%s' for writing\n", filePath);
+		free(output.buffer);
+		return 1;
+	}
+
+	if (format == kOutputFormatJSON)
+	{
+		writeSpectraJSON(&output, frequencyStep, spectra, names, spectrumCount);
+	}
+	else
+	{
+		writeSpectraCSV(&output, frequencyStep, spectra, names, spectrumCount);
+	}
+
+	flushOutput(&output);
+	if (fclose(output.stream) != 0)
+	{
+		output.hasError = 1;
+	}
+	free(output.buffer);
+
+	if (output.hasError)
+	{
+		printf("Error: failed to write to file at path '%s'\n", filePath);
+		return 1;
+	}
+
+	return 0;
+}
+
+int
+parseOutputFormat(const char * const name, OutputFormat * const format)
+{
+	if (strcmp(name, "csv") == 0)
+	{
+		*format = kOutputFormatCSV;
+		return 0;
+	}
+
+	if (strcmp(name, "json") == 0)
+	{
+		*format = kOutputFormatJSON;
+		return 0;
+	}
+
+	if (strcmp(name, "binary") == 0)
+	{
+		*format = kOutputFormatBinary;
+		return 0;
+	}
+
+	return 1;
+}
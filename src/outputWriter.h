@@ -0,0 +1,69 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "utils.h"
+#include <stddef.h>
+
+typedef enum
+{
+	kOutputFormatCSV,
+	kOutputFormatJSON,
+	kOutputFormatBinary,
+	kOutputFormatMaximum,
+} OutputFormat;
+
+/**
+ *	@brief Write one-sided spectra to a file, one value per frequency bin.
+ *	@note CSV and JSON files include the frequency of each bin. Binary sample files store the
+ *	frequency resolution (in Hz) in place of the sample period. Values are formatted with
+ *	enough significant digits to be read back exactly, and written in large blocks.
+ *
+ *	@param filePath      : Path to file to write.
+ *	@param format        : Output file format.
+ *	@param frequencyStep : Frequency resolution of the spectra in Hz.
+ *	@param spectra       : Array of Buffers of equal size holding each spectrum.
+ *	@param names         : Array of spectrum names.
+ *	@param spectrumCount : Number of spectra.
+ *	@return int          : 0 if success, 1 if error encountered
+ */
+int
+writeSpectra(
+	const char * const         filePath,
+	const OutputFormat         format,
+	const float                frequencyStep,
+	const Buffer * const       spectra,
+	const char * const * const names,
+	const size_t               spectrumCount);
+
+/**
+ *	@brief Parse the name of an output file format.
+ *
+ *	@param name   : Format name ("csv", "json" or "binary").
+ *	@param format : Pointer to location to store the format.
+ *	@return int   : 0 if success, 1 if the name is not recognised
+ */
+int
+parseOutputFormat(const char * const name, OutputFormat * const format);
@@ -0,0 +1,200 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "raoCache.h"
+#include "fileMapping.h"
+#include "sampleFile.h"
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static const char kRAOChannelName[] = "rao";
+
+/**
+ *	@brief Hash a length followed by the data, so that consecutive fields cannot alias.
+ */
+static uint64_t
+fnv1aField(const uint64_t hash, const void * const data, const size_t size)
+{
+	const uint64_t length = size;
+
+	return fnv1aHash(fnv1aHash(hash, &length, sizeof(length)), data, size);
+}
+
+/**
+ *	@brief Build the path of the cache file for a key.
+ *
+ *	@return int : 0 if success, 1 if the path is too long
+ */
+static int
+cacheFilePath(
+	char * const       path,
+	const size_t       pathSize,
+	const char * const directoryPath,
+	const uint64_t     key,
+	const char * const suffix)
+{
+	const int length = snprintf(
+		path,
+		pathSize,
+		"%s/rao-%016" PRIx64 ".bin%s",
+		directoryPath,
+		key,
+		suffix);
+
+	if (length < 0 || (size_t)length >= pathSize)
+	{
+		printf("Error: RAO cache directory path is too long: %s\n", directoryPath);
+		return 1;
+	}
+
+	return 0;
+}
+
+int
+raoCacheKey(
+	const char * const * const filePaths,
+	const size_t               fileCount,
+	const char * const * const selectors,
+	const size_t               selectorCount,
+	const float * const        parameters,
+	const size_t               parameterCount,
+	uint64_t * const           key)
+{
+	uint64_t hash = kFNV1aOffsetBasis;
+
+	for (size_t i = 0; i < fileCount; i++)
+	{
+		MappedFile file;
+
+		if (mapFile(filePaths[i], &file))
+		{
+			return 1;
+		}
+
+		hash = fnv1aField(hash, file.data, file.size);
+		unmapFile(&file);
+	}
+
+	for (size_t i = 0; i < selectorCount; i++)
+	{
+		hash = fnv1aField(hash, selectors[i], strlen(selectors[i]));
+	}
+
+	*key = fnv1aField(hash, parameters, parameterCount * sizeof(float));
+
+	return 0;
+}
+
+int
+raoCacheLoad(
+	const char * const directoryPath,
+	const uint64_t     key,
+	Buffer * const     RAOBuffer,
+	float * const      measurementPeriod)
+{
+	char          path[PATH_MAX];
+	MappedFile    file;
+	InputFileInfo info;
+	size_t        channelIndex;
+	int           returnValue;
+
+	if (cacheFilePath(path, sizeof(path), directoryPath, key, "") || access(path, R_OK) != 0)
+	{
+		return 1;
+	}
+
+	if (mapFile(path, &file))
+	{
+		return 1;
+	}
+
+	returnValue = !isSampleFile(&file) ||
+		      findSampleFileChannel(&file, kRAOChannelName, &channelIndex) ||
+		      readSampleFileChannel(&file, channelIndex, NULL, RAOBuffer, &info);
+	unmapFile(&file);
+
+	/*
+	 *	Spectra are calculated with power of two FFT sizes.
+	 */
+	if (returnValue == 0 && (RAOBuffer->size == 0 || (RAOBuffer->size & (RAOBuffer->size - 1))))
+	{
+		freeHeapBuffer(RAOBuffer);
+		RAOBuffer->heapPointer = NULL;
+		RAOBuffer->size = 0;
+		returnValue = 1;
+	}
+
+	if (returnValue != 0)
+	{
+		printf("Warning: ignoring invalid RAO cache file: %s\n", path);
+		return 1;
+	}
+
+	if (*measurementPeriod == 0)
+	{
+		*measurementPeriod = info.samplePeriod;
+	}
+
+	return 0;
+}
+
+int
+raoCacheStore(
+	const char * const   directoryPath,
+	const uint64_t       key,
+	const Buffer * const RAOBuffer,
+	const float          measurementPeriod)
+{
+	char               path[PATH_MAX];
+	char               temporaryPath[PATH_MAX];
+	char               suffix[32];
+	const char * const channelNames[] = {kRAOChannelName};
+
+	snprintf(suffix, sizeof(suffix), ".%ld.tmp", (long)getpid());
+
+	if (cacheFilePath(path, sizeof(path), directoryPath, key, "") ||
+	    cacheFilePath(temporaryPath, sizeof(temporaryPath), directoryPath, key, suffix))
+	{
+		return 1;
+	}
+
+	if (writeSampleFile(temporaryPath, RAOBuffer, channelNames, 1, measurementPeriod))
+	{
+		remove(temporaryPath);
+		return 1;
+	}
+
+	if (rename(temporaryPath, path) != 0)
+	{
+		printf("Error: could not rename file '%s' to '%s'\n", temporaryPath, path);
+		remove(temporaryPath);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,88 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "utils.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ *	@brief Calculate the cache key of an RAO characterisation.
+ *	@note The key is a 64-bit FNV-1a hash of the contents of the input files, the column
+ *	selectors and the characterisation parameters.
+ *
+ *	@param filePaths      : Array of paths to the test measurement input files.
+ *	@param fileCount      : Number of input files.
+ *	@param selectors      : Array of column selectors (may be NULL if selectorCount is 0).
+ *	@param selectorCount  : Number of column selectors.
+ *	@param parameters     : Array of parameters that affect the RAO (e.g., estimator settings).
+ *	@param parameterCount : Number of parameters.
+ *	@param key            : Pointer to location to store the key.
+ *	@return int           : 0 if success, 1 if an input file could not be read
+ */
+int
+raoCacheKey(
+	const char * const * const filePaths,
+	const size_t               fileCount,
+	const char * const * const selectors,
+	const size_t               selectorCount,
+	const float * const        parameters,
+	const size_t               parameterCount,
+	uint64_t * const           key);
+
+/**
+ *	@brief Load a cached RAO.
+ *
+ *	@param directoryPath     : Path to cache directory.
+ *	@param key               : Cache key from raoCacheKey().
+ *	@param RAOBuffer         : Pointer to Buffer to store the RAO.
+ *	@param measurementPeriod : Pointer to time period between successive measurements. If 0,
+ *	it is set to the period the RAO was characterised with.
+ *	@return int              : 0 if the RAO was loaded, 1 if it is not in the cache
+ */
+int
+raoCacheLoad(
+	const char * const directoryPath,
+	const uint64_t     key,
+	Buffer * const     RAOBuffer,
+	float * const      measurementPeriod);
+
+/**
+ *	@brief Store an RAO in the cache.
+ *	@note The cache file is written under a temporary name and then renamed, so concurrent
+ *	runs never load a partially written RAO.
+ *
+ *	@param directoryPath     : Path to cache directory.
+ *	@param key               : Cache key from raoCacheKey().
+ *	@param RAOBuffer         : Pointer to Buffer holding the RAO.
+ *	@param measurementPeriod : Time period between successive measurements (0 if unknown).
+ *	@return int              : 0 if success, 1 if error encountered
+ */
+int
+raoCacheStore(
+	const char * const   directoryPath,
+	const uint64_t       key,
+	const Buffer * const RAOBuffer,
+	const float          measurementPeriod);
@@ -0,0 +1,697 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "raoLibrary.h"
+#include "byteOrder.h"
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static const char  kRAOLibraryMagic[8] = "WSERAOL";
+static const float kFullCircle = 360;
+
+typedef enum
+{
+	kRAOLibraryHeaderSize = 32,
+	kRAOLibraryEntrySize = 128,
+	kOffsetVersion = 8,
+	kOffsetEntryCount = 12,
+	kOffsetSlotCount = 16,
+	kOffsetVesselId = 0,
+	kOffsetCondition = 32,
+	kOffsetKeyHash = 64,
+	kOffsetBinCount = 72,
+	kOffsetDataOffset = 80,
+	kOffsetFrequencyStep = 88,
+	kOffsetDraft = 96,
+	kOffsetHeading = 100,
+} RAOLibraryLayout;
+
+static uint64_t
+entryKeyHash(const char * const vesselId, const char * const condition)
+{
+	const char separator = '\0';
+	uint64_t   hash = kFNV1aOffsetBasis;
+
+	hash = fnv1aHash(hash, vesselId, strlen(vesselId));
+	hash = fnv1aHash(hash, &separator, 1);
+
+	return fnv1aHash(hash, condition, strlen(condition));
+}
+
+static const uint8_t *
+entryRecord(const RAOLibrary * const library, const size_t index)
+{
+	return (const uint8_t *)library->file.data + kRAOLibraryHeaderSize +
+	       4 * library->slotCount + kRAOLibraryEntrySize * index;
+}
+
+int
+openRAOLibrary(const char * const filePath, RAOLibrary * const library)
+{
+	const uint8_t * header;
+	size_t          tableEnd;
+
+	if (mapFile(filePath, &library->file))
+	{
+		return 1;
+	}
+
+	header = (const uint8_t *)library->file.data;
+	if (library->file.size < kRAOLibraryHeaderSize ||
+	    memcmp(header, kRAOLibraryMagic, sizeof(kRAOLibraryMagic)) != 0 ||
+	    loadLittleEndian32(header + kOffsetVersion) != kRAOLibraryVersion)
+	{
+		printf("Error: not an RAO library file: %s\n", filePath);
+		unmapFile(&library->file);
+		return 1;
+	}
+
+	library->entryCount = loadLittleEndian32(header + kOffsetEntryCount);
+	library->slotCount = loadLittleEndian32(header + kOffsetSlotCount);
+	tableEnd = kRAOLibraryHeaderSize + 4 * library->slotCount +
+		   kRAOLibraryEntrySize * library->entryCount;
+
+	/*
+	 *	Check the table and every entry once, so that lookups need no bounds checks.
+	 */
+	if (library->slotCount == 0 || (library->slotCount & (library->slotCount - 1)) ||
+	    library->slotCount < library->entryCount || tableEnd > library->file.size)
+	{
+		printf("Error: corrupt RAO library file: %s\n", filePath);
+		unmapFile(&library->file);
+		return 1;
+	}
+
+	for (size_t i = 0; i < library->entryCount; i++)
+	{
+		const uint8_t * const record = entryRecord(library, i);
+		const uint64_t        binCount = loadLittleEndian64(record + kOffsetBinCount);
+		const uint64_t        dataOffset = loadLittleEndian64(record + kOffsetDataOffset);
+
+		if (record[kOffsetVesselId + kRAOLibraryNameLength - 1] != '\0' ||
+		    record[kOffsetCondition + kRAOLibraryNameLength - 1] != '\0' ||
+		    dataOffset < tableEnd || dataOffset > library->file.size ||
+		    binCount > (library->file.size - dataOffset) / sizeof(float))
+		{
+			printf("Error: corrupt RAO library file: %s\n", filePath);
+			unmapFile(&library->file);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+void
+closeRAOLibrary(RAOLibrary * const library)
+{
+	unmapFile(&library->file);
+}
+
+int
+findRAOLibraryEntry(
+	const RAOLibrary * const library,
+	const char * const       vesselId,
+	const char * const       condition,
+	size_t * const           index)
+{
+	const uint64_t        hash = entryKeyHash(vesselId, condition);
+	const size_t          mask = library->slotCount - 1;
+	const uint8_t * const table = (const uint8_t *)library->file.data + kRAOLibraryHeaderSize;
+
+	for (size_t probe = 0; probe < library->slotCount; probe++)
+	{
+		const size_t   slot = (hash + probe) & mask;
+		const uint32_t slotValue = loadLittleEndian32(table + 4 * slot);
+		const uint8_t *record;
+
+		if (slotValue == 0 || slotValue > library->entryCount)
+		{
+			return 1;
+		}
+
+		record = entryRecord(library, slotValue - 1);
+		if (loadLittleEndian64(record + kOffsetKeyHash) == hash &&
+		    strcmp((const char *)record + kOffsetVesselId, vesselId) == 0 &&
+		    strcmp((const char *)record + kOffsetCondition, condition) == 0)
+		{
+			*index = slotValue - 1;
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+int
+readRAOLibraryEntry(
+	const RAOLibrary * const library,
+	const size_t             index,
+	RAOLibraryEntry * const  entry,
+	const int                isRAORead)
+{
+	const uint8_t * const record = entryRecord(library, index);
+	const uint64_t        frequencyStepBits = loadLittleEndian64(record + kOffsetFrequencyStep);
+
+	memcpy(entry->vesselId, record + kOffsetVesselId, kRAOLibraryNameLength);
+	memcpy(entry->condition, record + kOffsetCondition, kRAOLibraryNameLength);
+	memcpy(&entry->frequencyStep, &frequencyStepBits, sizeof(entry->frequencyStep));
+	entry->draft = loadLittleEndianFloat(record + kOffsetDraft);
+	entry->heading = loadLittleEndianFloat(record + kOffsetHeading);
+	entry->RAO.heapPointer = NULL;
+	entry->RAO.size = loadLittleEndian64(record + kOffsetBinCount);
+
+	if (!isRAORead)
+	{
+		return 0;
+	}
+
+	entry->RAO.heapPointer = (float *)malloc(entry->RAO.size * sizeof(float));
+	if (entry->RAO.heapPointer == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		return 1;
+	}
+
+	copyLittleEndianFloats(
+		entry->RAO.heapPointer,
+		(const uint8_t *)library->file.data + loadLittleEndian64(record + kOffsetDataOffset),
+		entry->RAO.size);
+
+	return 0;
+}
+
+/**
+ *	@brief Write a complete RAO library file.
+ *
+ *	@return int : 0 if success, 1 if error encountered
+ */
+static int
+writeRAOLibrary(
+	const char * const            filePath,
+	const RAOLibraryEntry * const entries,
+	const size_t                  entryCount)
+{
+	size_t     slotCount = 1;
+	size_t     dataOffset;
+	uint8_t *  table = NULL;
+	uint8_t *  records = NULL;
+	uint8_t    header[kRAOLibraryHeaderSize] = {0};
+	int        returnValue = 0;
+	FILE *     stream;
+
+	/*
+	 *	Keep the table at most half full so that probe sequences stay short.
+	 */
+	while (slotCount < 2 * entryCount)
+	{
+		slotCount *= 2;
+	}
+
+	table = (uint8_t *)calloc(slotCount, 4);
+	records = (uint8_t *)calloc(entryCount > 0 ? entryCount : 1, kRAOLibraryEntrySize);
+	if (table == NULL || records == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		free(table);
+		free(records);
+		return 1;
+	}
+
+	memcpy(header, kRAOLibraryMagic, sizeof(kRAOLibraryMagic));
+	storeLittleEndian32(header + kOffsetVersion, kRAOLibraryVersion);
+	storeLittleEndian32(header + kOffsetEntryCount, (uint32_t)entryCount);
+	storeLittleEndian32(header + kOffsetSlotCount, (uint32_t)slotCount);
+
+	dataOffset = kRAOLibraryHeaderSize + 4 * slotCount + kRAOLibraryEntrySize * entryCount;
+	for (size_t i = 0; i < entryCount; i++)
+	{
+		const RAOLibraryEntry * const entry = &entries[i];
+		uint8_t * const               record = records + kRAOLibraryEntrySize * i;
+		const uint64_t                hash = entryKeyHash(entry->vesselId, entry->condition);
+		uint64_t                      frequencyStepBits;
+		uint32_t                      draftBits;
+		uint32_t                      headingBits;
+		size_t                        slot = hash & (slotCount - 1);
+
+		while (loadLittleEndian32(table + 4 * slot) != 0)
+		{
+			slot = (slot + 1) & (slotCount - 1);
+		}
+		storeLittleEndian32(table + 4 * slot, (uint32_t)(i + 1));
+
+		memcpy(&frequencyStepBits, &entry->frequencyStep, sizeof(frequencyStepBits));
+		memcpy(&draftBits, &entry->draft, sizeof(draftBits));
+		memcpy(&headingBits, &entry->heading, sizeof(headingBits));
+		strncpy((char *)record + kOffsetVesselId, entry->vesselId, kRAOLibraryNameLength - 1);
+		strncpy((char *)record + kOffsetCondition, entry->condition, kRAOLibraryNameLength - 1);
+		storeLittleEndian64(record + kOffsetKeyHash, hash);
+		storeLittleEndian64(record + kOffsetBinCount, entry->RAO.size);
+		storeLittleEndian64(record + kOffsetDataOffset, dataOffset);
+		storeLittleEndian64(record + kOffsetFrequencyStep, frequencyStepBits);
+		storeLittleEndian32(record + kOffsetDraft, draftBits);
+		storeLittleEndian32(record + kOffsetHeading, headingBits);
+		dataOffset += entry->RAO.size * sizeof(float);
+	}
+
+	stream = fopen(filePath, "wb");
+	if (stream == NULL)
+	{
+		printf("Error: could not open file at path '%s' for writing\n", filePath);
+		free(table);
+		free(records);
+		return 1;
+	}
+
+	if (fwrite(header, sizeof(header), 1, stream) != 1 ||
+	    fwrite(table, 4, slotCount, stream) != slotCount ||
+	    fwrite(records, kRAOLibraryEntrySize, entryCount, stream) != entryCount)
+	{
+		returnValue = 1;
+	}
+
+	for (size_t i = 0; i < entryCount && returnValue == 0; i++)
+	{
+		const Buffer * const RAO = &entries[i].RAO;
+
+		if (hostIsLittleEndian())
+		{
+			if (fwrite(RAO->heapPointer, sizeof(float), RAO->size, stream) != RAO->size)
+			{
+				returnValue = 1;
+			}
+			continue;
+		}
+
+		for (size_t j = 0; j < RAO->size && returnValue == 0; j++)
+		{
+			uint32_t bits;
+			uint8_t  bytes[4];
+
+			memcpy(&bits, &RAO->heapPointer[j], sizeof(bits));
+			storeLittleEndian32(bytes, bits);
+			if (fwrite(bytes, sizeof(bytes), 1, stream) != 1)
+			{
+				returnValue = 1;
+			}
+		}
+	}
+
+	if (fclose(stream) != 0)
+	{
+		returnValue = 1;
+	}
+
+	if (returnValue != 0)
+	{
+		printf("Error: failed to write to file at path '%s'\n", filePath);
+	}
+
+	free(table);
+	free(records);
+
+	return returnValue;
+}
+
+int
+addRAOLibraryEntry(const char * const filePath, const RAOLibraryEntry * const entry)
+{
+	RAOLibrary        library;
+	RAOLibraryEntry * entries = NULL;
+	size_t            entryCount = 0;
+	char              temporaryPath[PATH_MAX];
+	int               isLibraryOpen = 0;
+	int               isEntryAdded = 0;
+	int               returnValue = 0;
+
+	if (memchr(entry->vesselId, '\0', kRAOLibraryNameLength) == NULL ||
+	    memchr(entry->condition, '\0', kRAOLibraryNameLength) == NULL)
+	{
+		printf("Error: RAO library vessel identifiers and loading conditions are limited to "
+		       "%d characters\n",
+		       kRAOLibraryNameLength - 1);
+		return 1;
+	}
+
+	if (access(filePath, F_OK) == 0)
+	{
+		if (openRAOLibrary(filePath, &library))
+		{
+			return 1;
+		}
+		isLibraryOpen = 1;
+	}
+
+	entries = (RAOLibraryEntry *)calloc(
+		(isLibraryOpen ? library.entryCount : 0) + 1,
+		sizeof(RAOLibraryEntry));
+	if (entries == NULL)
+	{
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	for (size_t i = 0; isLibraryOpen && i < library.entryCount; i++)
+	{
+		if (readRAOLibraryEntry(&library, i, &entries[entryCount], 1))
+		{
+			returnValue = 1;
+			goto RETURN;
+		}
+
+		if (strcmp(entries[entryCount].vesselId, entry->vesselId) == 0 &&
+		    strcmp(entries[entryCount].condition, entry->condition) == 0)
+		{
+			freeHeapBuffer(&entries[entryCount].RAO);
+			continue;
+		}
+		entryCount++;
+	}
+
+	entries[entryCount++] = *entry;
+	isEntryAdded = 1;
+
+	if (snprintf(temporaryPath, sizeof(temporaryPath), "%s.%ld.tmp", filePath, (long)getpid()) >=
+	    (int)sizeof(temporaryPath))
+	{
+		printf("Error: RAO library path is too long: %s\n", filePath);
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	if (writeRAOLibrary(temporaryPath, entries, entryCount))
+	{
+		remove(temporaryPath);
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	if (rename(temporaryPath, filePath) != 0)
+	{
+		printf("Error: could not rename file '%s' to '%s'\n", temporaryPath, filePath);
+		remove(temporaryPath);
+		returnValue = 1;
+	}
+
+RETURN:
+	/*
+	 *	The added entry belongs to the caller.
+	 */
+	for (size_t i = 0; entries != NULL && i + isEntryAdded < entryCount; i++)
+	{
+		freeHeapBuffer(&entries[i].RAO);
+	}
+	free(entries);
+	if (isLibraryOpen)
+	{
+		closeRAOLibrary(&library);
+	}
+
+	return returnValue;
+}
+
+static int
+compareFloats(const void * a, const void * b)
+{
+	const float x = *(const float *)a;
+	const float y = *(const float *)b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ *	@brief Sort values and remove duplicates.
+ *
+ *	@return size_t : Number of distinct values
+ */
+static size_t
+sortDistinct(float * const values, const size_t count)
+{
+	size_t distinctCount = 0;
+
+	qsort(values, count, sizeof(float), compareFloats);
+	for (size_t i = 0; i < count; i++)
+	{
+		if (distinctCount == 0 || values[i] != values[distinctCount - 1])
+		{
+			values[distinctCount++] = values[i];
+		}
+	}
+
+	return distinctCount;
+}
+
+static float
+wrapHeading(const float heading)
+{
+	const float wrapped = fmodf(heading, kFullCircle);
+
+	return wrapped < 0 ? wrapped + kFullCircle : wrapped;
+}
+
+/**
+ *	@brief Find the grid values either side of x, and the position of x between them.
+ *
+ *	@param values     : Pointer to sorted distinct grid values.
+ *	@param count      : Number of grid values (at least 1).
+ *	@param x          : Value to bracket.
+ *	@param isPeriodic : Non-zero if values wrap around at kFullCircle.
+ *	@param lower      : Pointer to location to store the grid value below x.
+ *	@param upper      : Pointer to location to store the grid value above x.
+ *	@return float     : Fraction of the way from lower to upper
+ */
+static float
+bracketValue(
+	const float * const values,
+	const size_t        count,
+	const float         x,
+	const int           isPeriodic,
+	float * const       lower,
+	float * const       upper)
+{
+	size_t i = 0;
+
+	while (i + 1 < count && values[i + 1] <= x)
+	{
+		i++;
+	}
+
+	if (isPeriodic)
+	{
+		/*
+		 *	Below the first heading, interpolate from the last heading across 360
+		 *	degrees.
+		 */
+		const size_t lowerIndex = x < values[0] ? count - 1 : i;
+		const size_t upperIndex = (lowerIndex + 1) % count;
+		const float  span = wrapHeading(values[upperIndex] - values[lowerIndex]);
+
+		*lower = values[lowerIndex];
+		*upper = values[upperIndex];
+
+		return span > 0 ? wrapHeading(x - *lower) / span : 0;
+	}
+
+	if (x <= values[0] || i + 1 == count)
+	{
+		*lower = *upper = values[x <= values[0] ? 0 : count - 1];
+		return 0;
+	}
+
+	*lower = values[i];
+	*upper = values[i + 1];
+
+	return (x - *lower) / (*upper - *lower);
+}
+
+int
+computeRAOBlend(
+	const RAOLibrary * const library,
+	const char * const       vesselId,
+	const float              draft,
+	const float              heading,
+	RAOBlend * const         blend)
+{
+	float * drafts = (float *)malloc((library->entryCount + 1) * sizeof(float));
+	float * headings = (float *)malloc((library->entryCount + 1) * sizeof(float));
+	size_t  gridEntryCount = 0;
+	size_t  draftCount;
+	size_t  headingCount;
+	float   cornerDrafts[2];
+	float   cornerHeadings[2];
+	float   draftFraction;
+	float   headingFraction;
+	int     returnValue = 0;
+
+	if (drafts == NULL || headings == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	for (size_t i = 0; i < library->entryCount; i++)
+	{
+		RAOLibraryEntry entry;
+
+		readRAOLibraryEntry(library, i, &entry, 0);
+		if (strcmp(entry.vesselId, vesselId) == 0 && isfinite(entry.draft) &&
+		    isfinite(entry.heading))
+		{
+			drafts[gridEntryCount] = entry.draft;
+			headings[gridEntryCount] = wrapHeading(entry.heading);
+			gridEntryCount++;
+		}
+	}
+
+	if (gridEntryCount == 0)
+	{
+		printf("Error: no RAOs with a draft and heading for vessel '%s' in RAO library\n",
+		       vesselId);
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	draftCount = sortDistinct(drafts, gridEntryCount);
+	headingCount = sortDistinct(headings, gridEntryCount);
+	draftFraction =
+		bracketValue(drafts, draftCount, draft, 0, &cornerDrafts[0], &cornerDrafts[1]);
+	headingFraction = bracketValue(
+		headings,
+		headingCount,
+		wrapHeading(heading),
+		1,
+		&cornerHeadings[0],
+		&cornerHeadings[1]);
+
+	/*
+	 *	Corner (j, k) is at cornerDrafts[j] and cornerHeadings[k].
+	 */
+	for (size_t corner = 0; corner < kRAOBlendCornerCount; corner++)
+	{
+		const size_t j = corner & 1;
+		const size_t k = corner >> 1;
+		int          isFound = 0;
+
+		blend->weights[corner] = (j ? draftFraction : 1 - draftFraction) *
+					 (k ? headingFraction : 1 - headingFraction);
+
+		for (size_t i = 0; i < library->entryCount && !isFound; i++)
+		{
+			RAOLibraryEntry entry;
+
+			readRAOLibraryEntry(library, i, &entry, 0);
+			if (strcmp(entry.vesselId, vesselId) == 0 &&
+			    entry.draft == cornerDrafts[j] &&
+			    wrapHeading(entry.heading) == cornerHeadings[k])
+			{
+				isFound = 1;
+				blend->indices[corner] = i;
+				if (corner == 0)
+				{
+					blend->binCount = entry.RAO.size;
+					blend->frequencyStep = entry.frequencyStep;
+				}
+				else if (entry.RAO.size != blend->binCount ||
+					 entry.frequencyStep != blend->frequencyStep)
+				{
+					printf("Error: the RAOs of vessel '%s' differ in size or "
+					       "frequency resolution\n",
+					       vesselId);
+					returnValue = 1;
+					goto RETURN;
+				}
+			}
+		}
+
+		if (!isFound)
+		{
+			printf("Error: no RAO for vessel '%s' at draft %f and heading %f in RAO "
+			       "library\n",
+			       vesselId,
+			       cornerDrafts[j],
+			       cornerHeadings[k]);
+			returnValue = 1;
+			goto RETURN;
+		}
+	}
+
+RETURN:
+	free(drafts);
+	free(headings);
+	return returnValue;
+}
+
+void
+blendRAOs(const RAOLibrary * const library, const RAOBlend * const blend, float * const RAO)
+{
+	for (size_t i = 0; i < blend->binCount; i++)
+	{
+		RAO[i] = 0;
+	}
+
+	for (size_t corner = 0; corner < kRAOBlendCornerCount; corner++)
+	{
+		const float           weight = blend->weights[corner];
+		const uint8_t * const record = entryRecord(library, blend->indices[corner]);
+		const uint8_t * const bins = (const uint8_t *)library->file.data +
+					     loadLittleEndian64(record + kOffsetDataOffset);
+
+		if (weight == 0)
+		{
+			continue;
+		}
+
+		/*
+		 *	Bins start at 4-byte aligned offsets, so on little endian hosts they are
+		 *	read in place with a loop the compiler vectorises.
+		 */
+		if (hostIsLittleEndian())
+		{
+			const float * const restrict source = (const float *)bins;
+			float * const restrict       destination = RAO;
+
+			for (size_t i = 0; i < blend->binCount; i++)
+			{
+				destination[i] += weight * source[i];
+			}
+			continue;
+		}
+
+		for (size_t i = 0; i < blend->binCount; i++)
+		{
+			RAO[i] += weight * loadLittleEndianFloat(bins + 4 * i);
+		}
+	}
+}
@@ -0,0 +1,199 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "fileMapping.h"
+#include "utils.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ *	RAO library file layout (all fields little endian):
+ *
+ *	offset  size  field
+ *	     0     8  magic ("WSERAOL" followed by a NUL byte)
+ *	     8     4  format version (kRAOLibraryVersion)
+ *	    12     4  number of entries (n)
+ *	    16     4  number of hash table slots (s, a power of two)
+ *	    20    12  reserved (zero)
+ *	    32    4s  hash table: index of the entry + 1 in each slot (0 if empty)
+ *	 32+4s  128n  entries:
+ *	              0   32  vessel identifier, NUL padded
+ *	             32   32  loading condition, NUL padded
+ *	             64    8  FNV-1a hash of the vessel identifier, a NUL byte and the condition
+ *	             72    8  number of RAO bins (the FFT size)
+ *	             80    8  offset of the RAO bins from the start of the file
+ *	             88    8  frequency resolution in Hz (IEEE 754 double)
+ *	             96    4  draft in metres (IEEE 754 float, NaN if unknown)
+ *	            100    4  heading relative to the waves in degrees (IEEE 754 float, NaN if unknown)
+ *	            104   24  reserved (zero)
+ *	   ...   ...  RAO bins (IEEE 754 float), entry after entry
+ *
+ *	Entries are found by hashing (vessel, condition) and probing the table linearly from slot
+ *	hash mod s.
+ */
+
+typedef enum
+{
+	kRAOLibraryVersion = 1,
+	kRAOLibraryNameLength = 32,
+	kRAOBlendCornerCount = 4,
+} RAOLibraryConstants;
+
+/**
+ *	@brief RAO library mapped into memory (read only), shared between processes through the
+ *	page cache.
+ *
+ */
+typedef struct RAOLibrary
+{
+	MappedFile file;
+	size_t     entryCount;
+	size_t     slotCount;
+} RAOLibrary;
+
+/**
+ *	@brief RAO characterisation of one vessel in one loading condition.
+ *
+ */
+typedef struct RAOLibraryEntry
+{
+	char   vesselId[kRAOLibraryNameLength];
+	char   condition[kRAOLibraryNameLength];
+	double frequencyStep;
+	float  draft;
+	float  heading;
+	Buffer RAO;
+} RAOLibraryEntry;
+
+/**
+ *	@brief Entries and weights that blend a vessel's RAOs into the RAO at one draft and heading.
+ *
+ */
+typedef struct RAOBlend
+{
+	size_t indices[kRAOBlendCornerCount];
+	float  weights[kRAOBlendCornerCount];
+	size_t binCount;
+	double frequencyStep;
+} RAOBlend;
+
+/**
+ *	@brief Map an RAO library file into memory and check its layout.
+ *
+ *	@param filePath : Path to RAO library file.
+ *	@param library  : Pointer to RAOLibrary to open.
+ *	@return int     : 0 if success, 1 if error encountered
+ */
+int
+openRAOLibrary(const char * const filePath, RAOLibrary * const library);
+
+/**
+ *	@brief Release an RAO library opened with openRAOLibrary().
+ *
+ *	@param library : Pointer to RAOLibrary.
+ */
+void
+closeRAOLibrary(RAOLibrary * const library);
+
+/**
+ *	@brief Look up the entry of a vessel and loading condition in constant time.
+ *
+ *	@param library   : Pointer to RAOLibrary.
+ *	@param vesselId  : Vessel identifier.
+ *	@param condition : Loading condition.
+ *	@param index     : Pointer to location to store the index of the entry.
+ *	@return int      : 0 if found, 1 if the library holds no such entry
+ */
+int
+findRAOLibraryEntry(
+	const RAOLibrary * const library,
+	const char * const       vesselId,
+	const char * const       condition,
+	size_t * const           index);
+
+/**
+ *	@brief Read an entry of an RAO library.
+ *
+ *	@param library     : Pointer to RAOLibrary.
+ *	@param index       : Index of the entry (less than library->entryCount).
+ *	@param entry       : Pointer to RAOLibraryEntry to store the entry.
+ *	@param isRAORead   : Non-zero to copy the RAO bins into entry->RAO (a heap Buffer), or 0 to
+ *	read only the metadata and number of bins (entry->RAO.heapPointer is then NULL).
+ *	@return int        : 0 if success, 1 if out of memory
+ */
+int
+readRAOLibraryEntry(
+	const RAOLibrary * const library,
+	const size_t             index,
+	RAOLibraryEntry * const  entry,
+	const int                isRAORead);
+
+/**
+ *	@brief Add an entry to an RAO library file, replacing any entry of the same vessel and
+ *	loading condition. The file is created if it does not exist.
+ *	@note The library is rewritten under a temporary name and renamed, so processes that have
+ *	the old library mapped are unaffected.
+ *
+ *	@param filePath : Path to RAO library file.
+ *	@param entry    : Pointer to entry to add.
+ *	@return int     : 0 if success, 1 if error encountered
+ */
+int
+addRAOLibraryEntry(const char * const filePath, const RAOLibraryEntry * const entry);
+
+/**
+ *	@brief Find the entries and bilinear weights that interpolate a vessel's RAO at a draft and
+ *	heading.
+ *	@note The vessel's entries with a known draft and heading must form a grid over (draft,
+ *	heading). Headings are in degrees and wrap around at 360. Drafts outside the grid are
+ *	clamped to its edge. This only needs to be done when the draft or heading change (e.g.,
+ *	once per segment of acceleration data), and blendRAOs() then costs one pass over the bins.
+ *
+ *	@param library  : Pointer to RAOLibrary.
+ *	@param vesselId : Vessel identifier.
+ *	@param draft    : Draft in metres.
+ *	@param heading  : Heading relative to the waves in degrees.
+ *	@param blend    : Pointer to RAOBlend to store the entries and weights.
+ *	@return int     : 0 if success, 1 if the vessel's entries do not cover the grid corners, or
+ *	the corner entries differ in size or frequency resolution
+ */
+int
+computeRAOBlend(
+	const RAOLibrary * const library,
+	const char * const       vesselId,
+	const float              draft,
+	const float              heading,
+	RAOBlend * const         blend);
+
+/**
+ *	@brief Blend RAOs of an RAO library with the weights from computeRAOBlend().
+ *
+ *	@param library : Pointer to RAOLibrary.
+ *	@param blend   : Pointer to RAOBlend.
+ *	@param RAO     : Pointer to buffer to store the blended RAO (blend->binCount elements).
+ */
+void
+blendRAOs(const RAOLibrary * const library, const RAOBlend * const blend, float * const RAO);
@@ -0,0 +1,391 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "sampleFile.h"
+#include "byteOrder.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+static const char kSampleFileMagic[kSampleFileMagicLength] = "WSESMPL";
+
+typedef enum
+{
+	kOffsetVersion = 8,
+	kOffsetDataType = 12,
+	kOffsetChannelCount = 16,
+	kOffsetSampleCount = 24,
+	kOffsetSamplePeriod = 32,
+	kOffsetCountScale = 40,
+	kOffsetCountOffset = 44,
+	kSwapBlockSize = 1024,
+} SampleFileLayout;
+
+/**
+ *	@brief Convert little endian int16 counts to scaled floats.
+ *	@note Written as a simple loop over independent elements so that the compiler vectorises it.
+ */
+static void
+convertInt16Counts(
+	float * const restrict         destination,
+	const uint8_t * const restrict source,
+	const size_t                   N,
+	const float                    scale,
+	const float                    offset)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		const int16_t count = (int16_t)((uint16_t)source[2 * i] |
+						((uint16_t)source[2 * i + 1] << 8));
+
+		destination[i] = (float)count * scale + offset;
+	}
+}
+
+/**
+ *	@brief Convert packed little endian int24 counts to scaled floats.
+ */
+static void
+convertInt24Counts(
+	float * const restrict         destination,
+	const uint8_t * const restrict source,
+	const size_t                   N,
+	const float                    scale,
+	const float                    offset)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		/*
+		 *	Assemble the count in the top 24 bits, then shift down to sign extend.
+		 */
+		const int32_t count = (int32_t)(((uint32_t)source[3 * i] << 8) |
+						((uint32_t)source[3 * i + 1] << 16) |
+						((uint32_t)source[3 * i + 2] << 24)) >>
+				      8;
+
+		destination[i] = (float)count * scale + offset;
+	}
+}
+
+static size_t
+sampleSize(const uint32_t dataType)
+{
+	switch (dataType)
+	{
+	case kSampleDataTypeFloat32:
+		return 4;
+	case kSampleDataTypeInt16:
+		return 2;
+	case kSampleDataTypeInt24:
+		return 3;
+	default:
+		return 0;
+	}
+}
+
+int
+isSampleFile(const MappedFile * const file)
+{
+	return file->size >= kSampleFileMagicLength &&
+	       memcmp(file->data, kSampleFileMagic, kSampleFileMagicLength) == 0;
+}
+
+int
+findSampleFileChannel(
+	const MappedFile * const file,
+	const char * const       selector,
+	size_t * const           channelIndex)
+{
+	const uint8_t * const bytes = (const uint8_t *)file->data;
+	uint32_t              channelCount;
+	char *                selectorEnd;
+	const unsigned long   index = strtoul(selector, &selectorEnd, 10);
+
+	if (!isSampleFile(file) || file->size < kSampleFileHeaderSize)
+	{
+		return 1;
+	}
+
+	channelCount = loadLittleEndian32(bytes + kOffsetChannelCount);
+
+	if (*selector != '\0' && *selectorEnd == '\0')
+	{
+		*channelIndex = index;
+		return index < channelCount ? 0 : 1;
+	}
+
+	for (size_t i = 0; i < channelCount; i++)
+	{
+		const size_t nameOffset = kSampleFileHeaderSize + i * kSampleFileChannelNameLength;
+
+		if (nameOffset + kSampleFileChannelNameLength > file->size)
+		{
+			return 1;
+		}
+
+		if (strncasecmp(file->data + nameOffset, selector, kSampleFileChannelNameLength) == 0)
+		{
+			*channelIndex = i;
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+int
+readSampleFileChannel(
+	const MappedFile * const   file,
+	const size_t               channelIndex,
+	const CountScaling * const scaling,
+	Buffer * const             buf,
+	InputFileInfo * const      info)
+{
+	const uint8_t * const bytes = (const uint8_t *)file->data;
+	uint32_t              version;
+	uint32_t              dataType;
+	uint64_t              channelCount;
+	uint64_t              sampleCount;
+	uint64_t              samplePeriodBits;
+	double                samplePeriod;
+	float                 countScale;
+	float                 countOffset;
+	size_t                bytesPerSample;
+	size_t                dataOffset;
+	const uint8_t *       channelData;
+
+	if (!isSampleFile(file) || file->size < kSampleFileHeaderSize)
+	{
+		printf("Error: binary sample file header is truncated\n");
+		return 1;
+	}
+
+	version = loadLittleEndian32(bytes + kOffsetVersion);
+	dataType = loadLittleEndian32(bytes + kOffsetDataType);
+	channelCount = loadLittleEndian32(bytes + kOffsetChannelCount);
+	sampleCount = loadLittleEndian64(bytes + kOffsetSampleCount);
+	samplePeriodBits = loadLittleEndian64(bytes + kOffsetSamplePeriod);
+	memcpy(&samplePeriod, &samplePeriodBits, sizeof(samplePeriod));
+	countScale = loadLittleEndianFloat(bytes + kOffsetCountScale);
+	countOffset = loadLittleEndianFloat(bytes + kOffsetCountOffset);
+	bytesPerSample = sampleSize(dataType);
+
+	if (scaling != NULL && !isnan(scaling->scale))
+	{
+		countScale = scaling->scale;
+	}
+
+	if (scaling != NULL && !isnan(scaling->offset))
+	{
+		countOffset = scaling->offset;
+	}
+
+	if (version != kSampleFileVersion)
+	{
+		printf("Error: unsupported binary sample file version %u\n", version);
+		return 1;
+	}
+
+	if (bytesPerSample == 0)
+	{
+		printf("Error: unsupported binary sample data type %u\n", dataType);
+		return 1;
+	}
+
+	if (channelIndex >= channelCount)
+	{
+		printf("Error: channel %zu requested from a binary sample file with %zu channels\n",
+		       channelIndex,
+		       (size_t)channelCount);
+		return 1;
+	}
+
+	dataOffset = kSampleFileHeaderSize + channelCount * kSampleFileChannelNameLength;
+	if (sampleCount > (SIZE_MAX - dataOffset) / bytesPerSample / channelCount ||
+	    dataOffset + channelCount * sampleCount * bytesPerSample > file->size)
+	{
+		printf("Error: binary sample file is truncated\n");
+		return 1;
+	}
+
+	if (sampleCount == 0)
+	{
+		buf->heapPointer = NULL;
+		buf->size = 0;
+		return 0;
+	}
+
+	buf->heapPointer = (float *)malloc(sampleCount * sizeof(float));
+	if (buf->heapPointer == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		return 1;
+	}
+
+	channelData = bytes + dataOffset + channelIndex * sampleCount * bytesPerSample;
+
+	switch (dataType)
+	{
+	case kSampleDataTypeInt16:
+		convertInt16Counts(
+			buf->heapPointer,
+			channelData,
+			sampleCount,
+			countScale,
+			countOffset);
+		break;
+	case kSampleDataTypeInt24:
+		convertInt24Counts(
+			buf->heapPointer,
+			channelData,
+			sampleCount,
+			countScale,
+			countOffset);
+		break;
+	case kSampleDataTypeFloat32:
+	default:
+		copyLittleEndianFloats(buf->heapPointer, channelData, sampleCount);
+		break;
+	}
+	buf->size = sampleCount;
+
+	if (info != NULL)
+	{
+		info->samplePeriod = samplePeriod;
+		info->channelCount = channelCount;
+		info->isCountData = (dataType != kSampleDataTypeFloat32);
+		info->countScale = countScale;
+		info->countOffset = countOffset;
+	}
+
+	return 0;
+}
+
+int
+writeSampleFile(
+	const char * const         filePath,
+	const Buffer * const       channels,
+	const char * const * const channelNames,
+	const size_t               channelCount,
+	const double               samplePeriod)
+{
+	uint8_t      header[kSampleFileHeaderSize] = {0};
+	const size_t sampleCount = channelCount > 0 ? channels[0].size : 0;
+	uint64_t     samplePeriodBits;
+	int          returnValue = 0;
+	FILE *       stream;
+
+	for (size_t i = 1; i < channelCount; i++)
+	{
+		if (channels[i].size != sampleCount)
+		{
+			printf("Error: all channels of a binary sample file must have the same length\n");
+			return 1;
+		}
+	}
+
+	stream = fopen(filePath, "wb");
+	if (stream == NULL)
+	{
+		printf("Error: could not open file at path '%s' for writing\n", filePath);
+		return 1;
+	}
+
+	memcpy(&samplePeriodBits, &samplePeriod, sizeof(samplePeriodBits));
+	memcpy(header, kSampleFileMagic, kSampleFileMagicLength);
+	storeLittleEndian32(header + kOffsetVersion, kSampleFileVersion);
+	storeLittleEndian32(header + kOffsetDataType, kSampleDataTypeFloat32);
+	storeLittleEndian32(header + kOffsetChannelCount, (uint32_t)channelCount);
+	storeLittleEndian64(header + kOffsetSampleCount, sampleCount);
+	storeLittleEndian64(header + kOffsetSamplePeriod, samplePeriodBits);
+
+	if (fwrite(header, sizeof(header), 1, stream) != 1)
+	{
+		returnValue = 1;
+	}
+
+	for (size_t i = 0; i < channelCount && returnValue == 0; i++)
+	{
+		char name[kSampleFileChannelNameLength] = {0};
+
+		if (channelNames != NULL && channelNames[i] != NULL)
+		{
+			strncpy(name, channelNames[i], sizeof(name) - 1);
+		}
+
+		if (fwrite(name, sizeof(name), 1, stream) != 1)
+		{
+			returnValue = 1;
+		}
+	}
+
+	for (size_t i = 0; i < channelCount && returnValue == 0; i++)
+	{
+		if (hostIsLittleEndian())
+		{
+			if (fwrite(channels[i].heapPointer, sizeof(float), sampleCount, stream) !=
+			    sampleCount)
+			{
+				returnValue = 1;
+			}
+			continue;
+		}
+
+		for (size_t j = 0; j < sampleCount && returnValue == 0; j += kSwapBlockSize)
+		{
+			uint8_t      block[kSwapBlockSize * sizeof(float)];
+			const size_t blockSize =
+				sampleCount - j < kSwapBlockSize ? sampleCount - j : kSwapBlockSize;
+
+			for (size_t k = 0; k < blockSize; k++)
+			{
+				uint32_t bits;
+
+				memcpy(&bits, &channels[i].heapPointer[j + k], sizeof(bits));
+				storeLittleEndian32(block + 4 * k, bits);
+			}
+
+			if (fwrite(block, sizeof(float), blockSize, stream) != blockSize)
+			{
+				returnValue = 1;
+			}
+		}
+	}
+
+	if (fclose(stream) != 0)
+	{
+		returnValue = 1;
+	}
+
+	if (returnValue != 0)
+	{
+		printf("Error: failed to write data to file at path '%s'\n", filePath);
+	}
+
+	return returnValue;
+}
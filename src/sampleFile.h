@@ -0,0 +1,125 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include "fileMapping.h"
+#include "utils.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ *	Binary sample file layout (all fields little endian):
+ *
+ *	offset  size  field
+ *	     0     8  magic ("WSESMPL" followed by a NUL byte)
+ *	     8     4  format version (kSampleFileVersion)
+ *	    12     4  sample data type (SampleDataType)
+ *	    16     4  number of channels
+ *	    20     4  reserved (zero)
+ *	    24     8  number of samples per channel
+ *	    32     8  time between successive samples in seconds (IEEE 754 double, 0 if unknown)
+ *	    40     4  count scale (IEEE 754 float, integer data types only)
+ *	    44     4  count offset (IEEE 754 float, integer data types only)
+ *	    48    16  reserved (zero)
+ *	    64   32n  channel names, NUL padded to kSampleFileChannelNameLength bytes each
+ *	64+32n   ...  samples, stored channel after channel
+ *
+ *	Integer samples are raw ADC counts, converted on load to count * scale + offset.
+ */
+
+typedef enum
+{
+	kSampleFileVersion = 1,
+	kSampleFileMagicLength = 8,
+	kSampleFileHeaderSize = 64,
+	kSampleFileChannelNameLength = 32,
+} SampleFileConstants;
+
+typedef enum
+{
+	kSampleDataTypeFloat32 = 0,
+	kSampleDataTypeInt16 = 1,
+	kSampleDataTypeInt24 = 2,
+} SampleDataType;
+
+/**
+ *	@brief Check whether a mapped file starts with the binary sample file magic number.
+ *
+ *	@param file : Pointer to mapped file.
+ *	@return int : 1 if the file is a binary sample file, else 0
+ */
+int
+isSampleFile(const MappedFile * const file);
+
+/**
+ *	@brief Find a channel of a mapped binary sample file.
+ *
+ *	@param file         : Pointer to mapped file.
+ *	@param selector     : Channel index (counting from 0) or channel name.
+ *	@param channelIndex : Pointer to location to store the channel index.
+ *	@return int         : 0 if success, 1 if no such channel exists
+ */
+int
+findSampleFileChannel(
+	const MappedFile * const file,
+	const char * const       selector,
+	size_t * const           channelIndex);
+
+/**
+ *	@brief Copy one channel of a mapped binary sample file into a heap Buffer, converting
+ *	integer counts to floats.
+ *
+ *	@param file         : Pointer to mapped file.
+ *	@param channelIndex : Index of channel to read.
+ *	@param scaling      : Pointer to count scaling overrides (may be NULL).
+ *	@param buf          : Pointer to Buffer to store the samples.
+ *	@param info         : Pointer to location to store file metadata (may be NULL).
+ *	@return int         : 0 if success, 1 if error encountered
+ */
+int
+readSampleFileChannel(
+	const MappedFile * const   file,
+	const size_t               channelIndex,
+	const CountScaling * const scaling,
+	Buffer * const             buf,
+	InputFileInfo * const      info);
+
+/**
+ *	@brief Write channels of equal length to a binary sample file.
+ *
+ *	@param filePath     : Path to file to write.
+ *	@param channels     : Array of Buffers holding each channel's samples.
+ *	@param channelNames : Array of channel names (may be NULL for unnamed channels).
+ *	@param channelCount : Number of channels.
+ *	@param samplePeriod : Time between successive samples in seconds (0 if unknown).
+ *	@return int         : 0 if success, 1 if error encountered
+ */
+int
+writeSampleFile(
+	const char * const         filePath,
+	const Buffer * const       channels,
+	const char * const * const channelNames,
+	const size_t               channelCount,
+	const double               samplePeriod);
@@ -23,16 +23,12 @@
  */
 
 #include "signalProcessing.h"
+#include <float.h>
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
-
-typedef struct Complex
-{
-	float real;
-	float imaginary;
-} Complex;
+#include <string.h>
 
 static void
 complexAdd(Complex * const result, const Complex * const A, const Complex * const B)
@@ -168,10 +164,88 @@ calculatePowerSpectrum(
 
 void
 periodogram(float * const S, const float * const F, const size_t N)
+{
+	spectrumMultiply(S, F, F, N);
+}
+
+void
+spectrumDivide(
+	float * const       result,
+	const float * const numerator,
+	const float * const denominator,
+	const size_t        N)
 {
 	for (size_t i = 0; i < N; i++)
 	{
-		S[i] = F[i] * F[i];
+		/*
+		 *	Zero denominators are replaced by one and INFINITY is added to their quotient, so
+		 *	the division is unconditional and the zero test compiles to a compare mask.
+		 */
+		const float d = denominator[i];
+		const int   isZero = d == 0;
+
+		result[i] = numerator[i] / (d + isZero) + (isZero ? INFINITY : 0);
+	}
+}
+
+void
+spectrumMultiply(
+	float * const       result,
+	const float * const A,
+	const float * const B,
+	const size_t        N)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		result[i] = A[i] * B[i];
+	}
+}
+
+void
+spectrumRegularisedDivide(
+	float * const       result,
+	const float * const numerator,
+	const float * const denominator,
+	const float         regularisation,
+	const size_t        N)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		/*
+		 *	Clamping the denominator keeps d / (d^2 + regularisation) at 0, not NaN, for
+		 *	infinite denominators (e.g., RAO bins masked for low coherence).
+		 */
+		const float d = denominator[i] < FLT_MAX ? denominator[i] : FLT_MAX;
+		const float scaledDenominator = d * d + regularisation;
+		const int   isZero = scaledDenominator == 0;
+
+		result[i] = numerator[i] * (d / (scaledDenominator + isZero)) + (isZero ? INFINITY : 0);
+	}
+}
+
+void
+spectrumFlooredDivide(
+	float * const       result,
+	const float * const numerator,
+	const float * const denominator,
+	const float         floor,
+	const size_t        N)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		const float d = denominator[i] > floor ? denominator[i] : floor;
+		const int   isZero = d == 0;
+
+		result[i] = numerator[i] / (d + isZero) + (isZero ? INFINITY : 0);
+	}
+}
+
+void
+spectrumMagnitudeSquared(float * const result, const Complex * const F, const size_t N)
+{
+	for (size_t i = 0; i < N; i++)
+	{
+		result[i] = F[i].real * F[i].real + F[i].imaginary * F[i].imaginary;
 	}
 }
 
@@ -204,3 +278,89 @@ fft(float * const F, const float * const x, const size_t N)
 
 	return 0;
 }
+
+void
+complexFFT(Complex * const F, const Complex * const x, const size_t N)
+{
+	dit2FFT(F, x, N, 1);
+}
+
+int
+calculatePowerSpectrumFromComplex(
+	float * const         powerSpectrum,
+	const Complex * const x,
+	const size_t          N)
+{
+	Complex * const F = (Complex *)calloc(N, sizeof(Complex));
+
+	if (F == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		return 1;
+	}
+
+	dit2FFT(F, x, N, 1);
+
+	spectrumMagnitudeSquared(powerSpectrum, F, N);
+
+	free(F);
+
+	return 0;
+}
+
+float
+windowCoefficient(const WindowType type, const size_t i, const size_t N)
+{
+	switch (type)
+	{
+	case kWindowHann:
+		if (N < 2)
+		{
+			return 1;
+		}
+		return 0.5 * (1.0 - cosf(2.0 * acos(-1) * i / (N - 1)));
+	case kWindowRectangular:
+	default:
+		return 1;
+	}
+}
+
+float
+windowPower(const WindowType type, const size_t N)
+{
+	double total = 0;
+
+	if (type == kWindowRectangular || N == 0)
+	{
+		return 1;
+	}
+
+	for (size_t i = 0; i < N; i++)
+	{
+		const float coefficient = windowCoefficient(type, i, N);
+
+		total += coefficient * coefficient;
+	}
+
+	return total / N;
+}
+
+int
+parseWindowType(const char * const name, WindowType * const type)
+{
+	if (strcmp(name, "rectangular") == 0)
+	{
+		*type = kWindowRectangular;
+		return 0;
+	}
+
+	if (strcmp(name, "hann") == 0)
+	{
+		*type = kWindowHann;
+		return 0;
+	}
+
+	return 1;
+}
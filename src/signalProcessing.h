@@ -26,6 +26,19 @@
 
 #include <stddef.h>
 
+typedef struct Complex
+{
+	float real;
+	float imaginary;
+} Complex;
+
+typedef enum
+{
+	kWindowRectangular,
+	kWindowHann,
+	kWindowMaximum,
+} WindowType;
+
 /**
  *	@brief Round up a size_t value to the next highest power of two.
  *
@@ -64,6 +77,86 @@ calculatePowerSpectrum(
 void
 periodogram(float * const S, const float * const F, const size_t N);
 
+/**
+ *	@brief Divide two spectra bin by bin, with INFINITY where the denominator is zero.
+ *	@note The spectral kernels have no data dependent branches, so the compiler can vectorise
+ *	them. The result buffer may be the same as either input buffer.
+ *
+ *	@param result      : Pointer to buffer to store the quotient.
+ *	@param numerator   : Pointer to buffer containing the numerator spectrum.
+ *	@param denominator : Pointer to buffer containing the denominator spectrum.
+ *	@param N           : Number of elements in each buffer.
+ */
+void
+spectrumDivide(
+	float * const       result,
+	const float * const numerator,
+	const float * const denominator,
+	const size_t        N);
+
+/**
+ *	@brief Multiply two spectra bin by bin.
+ *
+ *	@param result : Pointer to buffer to store the product.
+ *	@param A      : Pointer to buffer containing the first spectrum.
+ *	@param B      : Pointer to buffer containing the second spectrum.
+ *	@param N      : Number of elements in each buffer.
+ */
+void
+spectrumMultiply(
+	float * const       result,
+	const float * const A,
+	const float * const B,
+	const size_t        N);
+
+/**
+ *	@brief Divide two spectra bin by bin with Tikhonov regularisation, i.e.,
+ *	numerator * denominator / (denominator^2 + regularisation).
+ *	@note With zero regularisation this is spectrumDivide(), including INFINITY where the
+ *	denominator is zero.
+ *
+ *	@param result         : Pointer to buffer to store the quotient.
+ *	@param numerator      : Pointer to buffer containing the numerator spectrum.
+ *	@param denominator    : Pointer to buffer containing the denominator spectrum.
+ *	@param regularisation : Regularisation added to the squared denominator (>= 0).
+ *	@param N              : Number of elements in each buffer.
+ */
+void
+spectrumRegularisedDivide(
+	float * const       result,
+	const float * const numerator,
+	const float * const denominator,
+	const float         regularisation,
+	const size_t        N);
+
+/**
+ *	@brief Divide two spectra bin by bin, with the denominator raised to at least a floor.
+ *	@note With a zero floor this is spectrumDivide().
+ *
+ *	@param result      : Pointer to buffer to store the quotient.
+ *	@param numerator   : Pointer to buffer containing the numerator spectrum.
+ *	@param denominator : Pointer to buffer containing the denominator spectrum.
+ *	@param floor       : Smallest denominator divided by (>= 0).
+ *	@param N           : Number of elements in each buffer.
+ */
+void
+spectrumFlooredDivide(
+	float * const       result,
+	const float * const numerator,
+	const float * const denominator,
+	const float         floor,
+	const size_t        N);
+
+/**
+ *	@brief Calculate the squared magnitude of each bin of a complex spectrum.
+ *
+ *	@param result : Pointer to buffer to store the squared magnitudes.
+ *	@param F      : Pointer to buffer containing the complex spectrum.
+ *	@param N      : Number of elements in each buffer.
+ */
+void
+spectrumMagnitudeSquared(float * const result, const Complex * const F, const size_t N);
+
 /**
  *	@brief Perform FFT on time series data.
  *	@note Time series data is zero padded so that array size is a power of two.
@@ -77,3 +170,62 @@ periodogram(float * const S, const float * const F, const size_t N);
  */
 int
 fft(float * const F, const float * const x, const size_t N);
+
+/**
+ *	@brief Perform FFT on complex time series data.
+ *
+ *	@param F : Pointer to buffer to store complex frequency spectrum (N elements).
+ *	@param x : Pointer to buffer containing complex time series data (N elements).
+ *	@param N : Number of elements in each buffer. Must be a power of two.
+ */
+void
+complexFFT(Complex * const F, const Complex * const x, const size_t N);
+
+/**
+ *	@brief Calculate power spectrum from complex time series data that has already been
+ *	zero padded to a power of two length.
+ *	@note This avoids the intermediate magnitude spectrum and input copy used by
+ *	calculatePowerSpectrum(), for callers that can write directly into the FFT input.
+ *
+ *	@param powerSpectrum : Pointer to buffer to store power spectrum (N elements).
+ *	@param x             : Pointer to buffer containing complex time series data.
+ *	@param N             : Number of elements in each buffer. Must be a power of two.
+ *	@return int : 0 if success, 1 if error encountered.
+ */
+int
+calculatePowerSpectrumFromComplex(
+	float * const         powerSpectrum,
+	const Complex * const x,
+	const size_t          N);
+
+/**
+ *	@brief Calculate the coefficient of a window function.
+ *
+ *	@param type   : Window function.
+ *	@param i      : Index of the sample within the window.
+ *	@param N      : Length of the window.
+ *	@return float : Window coefficient for sample i.
+ */
+float
+windowCoefficient(const WindowType type, const size_t i, const size_t N);
+
+/**
+ *	@brief Calculate the mean squared coefficient of a window function, i.e., the fraction of
+ *	the power of a signal that the window passes.
+ *
+ *	@param type   : Window function.
+ *	@param N      : Length of the window.
+ *	@return float : Mean of the squared window coefficients.
+ */
+float
+windowPower(const WindowType type, const size_t N);
+
+/**
+ *	@brief Parse a window function name.
+ *
+ *	@param name : Window name ("rectangular" or "hann").
+ *	@param type : Pointer to location to store the parsed window type.
+ *	@return int : 0 if success, 1 if the name is not recognised.
+ */
+int
+parseWindowType(const char * const name, WindowType * const type);
@@ -0,0 +1,225 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "spectralPartition.h"
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+/**
+ *	@brief Merge a partition into the partition directly above it in frequency.
+ */
+static void
+mergePartitions(SpectralPartition * const lower, const SpectralPartition * const upper)
+{
+	lower->lastBin = upper->lastBin;
+	lower->energy += upper->energy;
+	if (upper->peakValue > lower->peakValue)
+	{
+		lower->peakValue = upper->peakValue;
+		lower->peakBin = upper->peakBin;
+	}
+}
+
+/**
+ *	@brief Depth of the trough below the upper of two neighbouring partitions, as a fraction of
+ *	the lower of their peaks (1 for no trough at all).
+ */
+static float
+troughFraction(const SpectralPartition * const lower, const SpectralPartition * const upper)
+{
+	const float lowerPeak =
+		lower->peakValue < upper->peakValue ? lower->peakValue : upper->peakValue;
+
+	return lowerPeak > 0 ? upper->troughValue / lowerPeak : 1;
+}
+
+/**
+ *	@brief Merge partitions[index + 1] into partitions[index] and close the gap.
+ */
+static void
+mergeAt(SpectralPartition * const partitions, size_t * const count, const size_t index)
+{
+	mergePartitions(&partitions[index], &partitions[index + 1]);
+	memmove(&partitions[index + 1],
+		&partitions[index + 2],
+		(*count - index - 2) * sizeof(SpectralPartition));
+	(*count)--;
+}
+
+/**
+ *	@brief Append a completed partition, merging it with its lower neighbours while the trough
+ *	between them is too shallow.
+ */
+static void
+pushPartition(
+	SpectralPartition * const               partitions,
+	size_t * const                          count,
+	SpectralPartition                       partition,
+	const SpectralPartitionSettings * const settings)
+{
+	while (*count > 0 &&
+	       troughFraction(&partitions[*count - 1], &partition) >= settings->troughRatio)
+	{
+		SpectralPartition lower = partitions[--*count];
+
+		mergePartitions(&lower, &partition);
+		partition = lower;
+	}
+
+	if (*count == kMaximumSpectralPartitions)
+	{
+		/*
+		 *	Out of room: merge the neighbouring pair (including the new partition) with the
+		 *	shallowest trough between them.
+		 */
+		size_t shallowest = *count - 1;
+		float  shallowestFraction = troughFraction(&partitions[*count - 1], &partition);
+
+		for (size_t i = 0; i + 1 < *count; i++)
+		{
+			const float fraction = troughFraction(&partitions[i], &partitions[i + 1]);
+
+			if (fraction > shallowestFraction)
+			{
+				shallowest = i;
+				shallowestFraction = fraction;
+			}
+		}
+
+		if (shallowest == *count - 1)
+		{
+			mergePartitions(&partitions[*count - 1], &partition);
+			return;
+		}
+
+		mergeAt(partitions, count, shallowest);
+	}
+
+	partitions[(*count)++] = partition;
+}
+
+size_t
+partitionWaveSpectrum(
+	SpectralPartition * const               partitions,
+	const float * const                     spectrum,
+	const size_t                            binCount,
+	const double                            frequencyStep,
+	const double                            densityScale,
+	const SpectralPartitionSettings * const settings)
+{
+	SpectralPartition current = {0};
+	size_t            count = 0;
+	float             previous = 0;
+	int               isDescending = 0;
+	double            totalEnergy = 0;
+
+	if (binCount < 2)
+	{
+		return 0;
+	}
+
+	current.firstBin = 1;
+	current.peakBin = 1;
+
+	for (size_t i = 1; i < binCount; i++)
+	{
+		const float value = spectrum[i] <= FLT_MAX ? spectrum[i] : 0;
+
+		/*
+		 *	A rise after a fall closes the partition at the local minimum.
+		 */
+		if (i > current.firstBin && isDescending && value > previous)
+		{
+			current.lastBin = i - 1;
+			pushPartition(partitions, &count, current, settings);
+			current = (SpectralPartition){
+				.firstBin = i,
+				.peakBin = i,
+				.troughValue = previous,
+			};
+		}
+
+		current.energy += value;
+		if (value > current.peakValue)
+		{
+			current.peakValue = value;
+			current.peakBin = i;
+		}
+
+		if (value != previous)
+		{
+			isDescending = value < previous;
+		}
+		previous = value;
+	}
+
+	current.lastBin = binCount - 1;
+	pushPartition(partitions, &count, current, settings);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		totalEnergy += partitions[i].energy;
+	}
+
+	/*
+	 *	Fold partitions with negligible energy into a neighbour, smallest first.
+	 */
+	while (count > 1)
+	{
+		size_t smallest = 0;
+
+		for (size_t i = 1; i < count; i++)
+		{
+			if (partitions[i].energy < partitions[smallest].energy)
+			{
+				smallest = i;
+			}
+		}
+
+		if (partitions[smallest].energy >= settings->minimumEnergyFraction * totalEnergy)
+		{
+			break;
+		}
+
+		if (smallest == 0 || (smallest + 1 < count && partitions[smallest + 1].troughValue >
+								       partitions[smallest].troughValue))
+		{
+			mergeAt(partitions, &count, smallest);
+		}
+		else
+		{
+			mergeAt(partitions, &count, smallest - 1);
+		}
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		partitions[i].significantWaveHeight =
+			4 * sqrt(partitions[i].energy * densityScale * frequencyStep);
+		partitions[i].peakPeriod = 1 / (partitions[i].peakBin * frequencyStep);
+	}
+
+	return count;
+}
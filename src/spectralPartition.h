@@ -0,0 +1,99 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+typedef enum
+{
+	kMaximumSpectralPartitions = 8,
+} SpectralPartitionConstants;
+
+/**
+ *	@brief One partition (e.g., a swell or wind sea system) of a wave energy spectrum.
+ *
+ */
+typedef struct SpectralPartition
+{
+	size_t firstBin;
+	size_t lastBin;
+	size_t peakBin;
+	float  peakValue;
+	/*
+	 *	Spectrum value at the trough separating the partition from the one below it
+	 */
+	float  troughValue;
+	/*
+	 *	Zeroth spectral moment of the partition
+	 */
+	double energy;
+	float  significantWaveHeight;
+	float  peakPeriod;
+} SpectralPartition;
+
+/**
+ *	@brief Criteria for merging neighbouring partitions.
+ *
+ */
+typedef struct SpectralPartitionSettings
+{
+	/*
+	 *	Neighbouring partitions are merged when the trough between them is at least this
+	 *	fraction of the lower of their two peaks.
+	 */
+	float troughRatio;
+	/*
+	 *	Partitions holding less than this fraction of the total energy are merged into the
+	 *	neighbour they share the higher trough with.
+	 */
+	float minimumEnergyFraction;
+} SpectralPartitionSettings;
+
+/**
+ *	@brief Partition a wave energy spectrum into its wave systems by a watershed on the 1D
+ *	spectrum.
+ *	@note Each local maximum starts a partition, bounded by the local minima either side.
+ *	Partitions are merged on the fly as the spectrum is scanned once, so only
+ *	kMaximumSpectralPartitions partitions are ever held. When that many distinct partitions
+ *	are open, the neighbouring pair with the shallowest trough between them is merged. The 0 Hz
+ *	bin is skipped and bins that are not finite count as zero.
+ *
+ *	@param partitions    : Pointer to array of kMaximumSpectralPartitions partitions to store
+ *	the partitions in order of frequency.
+ *	@param spectrum      : Pointer to buffer containing the spectrum from 0 Hz.
+ *	@param binCount      : Number of bins (e.g., up to but excluding the Nyquist frequency).
+ *	@param frequencyStep : Frequency resolution of the spectrum in Hz.
+ *	@param densityScale  : Factor converting the spectrum bins to a one-sided spectral density.
+ *	@param settings      : Pointer to merge criteria.
+ *	@return size_t       : Number of partitions
+ */
+size_t
+partitionWaveSpectrum(
+	SpectralPartition * const               partitions,
+	const float * const                     spectrum,
+	const size_t                            binCount,
+	const double                            frequencyStep,
+	const double                            densityScale,
+	const SpectralPartitionSettings * const settings);
@@ -0,0 +1,700 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "spectrumFit.h"
+#include "waveStatistics.h"
+#include <float.h>
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+
+static const double kPiersonMoskowitzShape = 1.25;
+static const double kJONSWAPDefaultPeakEnhancement = 3.3;
+static const double kJONSWAPNormalisationSlope = 0.287;
+static const double kJONSWAPWidthBelowPeak = 0.07;
+static const double kJONSWAPWidthAbovePeak = 0.09;
+static const double kMinimumWaveHeight = 1e-6;
+static const double kMinimumPeakEnhancement = 1;
+static const double kMaximumPeakEnhancement = 20;
+static const double kMinimumOchiHubbleShape = 0.25;
+static const double kMaximumOchiHubbleShape = 20;
+static const double kConvergenceTolerance = 1e-8;
+
+static const char * const kSpectrumModelNames[kSpectrumModelMaximum] = {
+	[kSpectrumModelPiersonMoskowitz] = "pm",
+	[kSpectrumModelJONSWAP] = "jonswap",
+	[kSpectrumModelOchiHubble] = "ochi-hubble",
+};
+
+static const char * const kParameterNames[kSpectrumModelMaximum][kSpectrumFitMaximumParameters] = {
+	[kSpectrumModelPiersonMoskowitz] = {"Hs", "fp"},
+	[kSpectrumModelJONSWAP] = {"Hs", "fp", "gamma"},
+	[kSpectrumModelOchiHubble] = {"Hs1", "fp1", "lambda1", "Hs2", "fp2", "lambda2"},
+};
+
+/**
+ *	@brief Digamma function, by recurrence up to x >= 6 and its asymptotic series.
+ */
+static double
+digamma(double x)
+{
+	double result = 0;
+	double inverseSquare;
+
+	while (x < 6)
+	{
+		result -= 1 / x;
+		x += 1;
+	}
+
+	inverseSquare = 1 / (x * x);
+
+	return result + log(x) - 0.5 / x -
+	       inverseSquare *
+		       (1.0 / 12 -
+			inverseSquare * (1.0 / 120 - inverseSquare * (1.0 / 252 - inverseSquare / 240)));
+}
+
+/**
+ *	@brief Logarithm of the gamma function for x > 0, by recurrence up to x >= 7 and Stirling's
+ *	series (lgamma() is not thread safe, as it sets signgam).
+ */
+static double
+logGamma(double x)
+{
+	double result = 0;
+	double inverseSquare;
+
+	while (x < 7)
+	{
+		result -= log(x);
+		x += 1;
+	}
+
+	inverseSquare = 1 / (x * x);
+
+	return result + (x - 0.5) * log(x) - x + 0.5 * log(2 * acos(-1)) +
+	       (1.0 / 12 - inverseSquare * (1.0 / 360 - inverseSquare / 1260)) / x;
+}
+
+/**
+ *	@brief Evaluate a Pierson-Moskowitz spectrum, 5/16 Hs^2 fp^4 f^-5 exp(-5/4 (fp / f)^4),
+ *	and optionally its gradient with respect to (Hs, fp).
+ */
+static double
+piersonMoskowitz(const double Hs, const double fp, const double f, double * const gradient)
+{
+	const double x = fp / f;
+	const double x4 = x * x * x * x;
+	const double S = 5.0 / 16 * Hs * Hs * x4 / f * exp(-kPiersonMoskowitzShape * x4);
+
+	if (gradient != NULL)
+	{
+		gradient[0] = 2 * S / Hs;
+		gradient[1] = S / fp * (4 - 4 * kPiersonMoskowitzShape * x4);
+	}
+
+	return S;
+}
+
+/**
+ *	@brief Evaluate a JONSWAP spectrum, (1 - 0.287 ln gamma) PM(f) gamma^r with
+ *	r = exp(-(f - fp)^2 / (2 sigma^2 fp^2)), and optionally its gradient with respect to
+ *	(Hs, fp, gamma).
+ */
+static double
+jonswap(const double * const parameters, const double f, double * const gradient)
+{
+	const double Hs = parameters[0];
+	const double fp = parameters[1];
+	const double gamma = parameters[2];
+	const double sigma = f <= fp ? kJONSWAPWidthBelowPeak : kJONSWAPWidthAbovePeak;
+	const double u = (f - fp) / (sigma * fp);
+	const double r = exp(-0.5 * u * u);
+	const double logGamma = log(gamma);
+	const double normalisation = 1 - kJONSWAPNormalisationSlope * logGamma;
+	const double x = fp / f;
+	const double x4 = x * x * x * x;
+	const double S = normalisation * piersonMoskowitz(Hs, fp, f, NULL) * exp(r * logGamma);
+
+	if (gradient != NULL)
+	{
+		gradient[0] = 2 * S / Hs;
+		gradient[1] = S * ((4 - 4 * kPiersonMoskowitzShape * x4) / fp +
+				   logGamma * u * r * f / (sigma * fp * fp));
+		gradient[2] =
+			S * (r / gamma - kJONSWAPNormalisationSlope / (gamma * normalisation));
+	}
+
+	return S;
+}
+
+/**
+ *	@brief Evaluate one Ochi-Hubble component,
+ *	1/4 (c fp^4)^lambda / Gamma(lambda) Hs^2 f^-(4 lambda + 1) exp(-c (fp / f)^4) with
+ *	c = lambda + 1/4, and optionally its gradient with respect to (Hs, fp, lambda).
+ */
+static double
+ochiHubbleComponent(const double * const parameters, const double f, double * const gradient)
+{
+	const double Hs = parameters[0];
+	const double fp = parameters[1];
+	const double lambda = parameters[2];
+	const double c = lambda + 0.25;
+	const double x = fp / f;
+	const double x4 = x * x * x * x;
+	const double logShape = log(c * x4);
+	const double S =
+		exp(log(0.25 * Hs * Hs / f) + lambda * logShape - logGamma(lambda) - c * x4);
+
+	if (gradient != NULL)
+	{
+		gradient[0] = 2 * S / Hs;
+		gradient[1] = 4 * S / fp * (lambda - c * x4);
+		gradient[2] = S * (logShape + lambda / c - digamma(lambda) - x4);
+	}
+
+	return S;
+}
+
+/**
+ *	@brief Evaluate a spectrum model and optionally its gradient with respect to its
+ *	parameters.
+ */
+static double
+evaluateModel(
+	const SpectrumModelType model,
+	const double * const    parameters,
+	const double            f,
+	double * const          gradient)
+{
+	switch (model)
+	{
+	case kSpectrumModelJONSWAP:
+		return jonswap(parameters, f, gradient);
+	case kSpectrumModelOchiHubble:
+		return ochiHubbleComponent(parameters, f, gradient) +
+		       ochiHubbleComponent(&parameters[3], f, gradient != NULL ? &gradient[3] : NULL);
+	case kSpectrumModelPiersonMoskowitz:
+	default:
+		return piersonMoskowitz(parameters[0], parameters[1], f, gradient);
+	}
+}
+
+size_t
+spectrumModelParameterCount(const SpectrumModelType model)
+{
+	switch (model)
+	{
+	case kSpectrumModelJONSWAP:
+		return 3;
+	case kSpectrumModelOchiHubble:
+		return 6;
+	case kSpectrumModelPiersonMoskowitz:
+	default:
+		return 2;
+	}
+}
+
+double
+evaluateSpectrumModel(
+	const SpectrumModelType model,
+	const double * const    parameters,
+	const double            frequency)
+{
+	return evaluateModel(model, parameters, frequency, NULL);
+}
+
+/**
+ *	@brief Get the range of each parameter where the models are defined.
+ */
+static void
+parameterBounds(
+	const SpectrumModelType model,
+	const double            minimumFrequency,
+	const double            maximumFrequency,
+	double * const          lower,
+	double * const          upper)
+{
+	for (size_t component = 0; component < 2; component++)
+	{
+		double * const componentLower = &lower[3 * component];
+		double * const componentUpper = &upper[3 * component];
+
+		componentLower[0] = kMinimumWaveHeight;
+		componentUpper[0] = INFINITY;
+		componentLower[1] = minimumFrequency;
+		componentUpper[1] = maximumFrequency;
+		componentLower[2] = model == kSpectrumModelJONSWAP ? kMinimumPeakEnhancement
+								 : kMinimumOchiHubbleShape;
+		componentUpper[2] = model == kSpectrumModelJONSWAP ? kMaximumPeakEnhancement
+								 : kMaximumOchiHubbleShape;
+	}
+}
+
+/**
+ *	@brief Sum of squared residuals of a model, and optionally the Gauss-Newton normal
+ *	equations J^T J and J^T r.
+ */
+static double
+evaluateCost(
+	const SpectrumModelType model,
+	const double * const    parameters,
+	const float * const     spectrum,
+	const size_t            binCount,
+	const double            frequencyStep,
+	const double            densityScale,
+	double (*const normalMatrix)[kSpectrumFitMaximumParameters],
+	double * const          gradient)
+{
+	const size_t parameterCount = spectrumModelParameterCount(model);
+	double       cost = 0;
+
+	if (normalMatrix != NULL)
+	{
+		for (size_t j = 0; j < parameterCount; j++)
+		{
+			gradient[j] = 0;
+			for (size_t k = 0; k < parameterCount; k++)
+			{
+				normalMatrix[j][k] = 0;
+			}
+		}
+	}
+
+	for (size_t i = 1; i < binCount; i++)
+	{
+		const double f = i * frequencyStep;
+		double       jacobian[kSpectrumFitMaximumParameters];
+		double       residual;
+
+		if (!(spectrum[i] <= FLT_MAX))
+		{
+			continue;
+		}
+
+		residual = evaluateModel(model, parameters, f, normalMatrix != NULL ? jacobian : NULL) -
+			   densityScale * spectrum[i];
+		cost += residual * residual;
+
+		if (normalMatrix != NULL)
+		{
+			for (size_t j = 0; j < parameterCount; j++)
+			{
+				gradient[j] += jacobian[j] * residual;
+				for (size_t k = 0; k <= j; k++)
+				{
+					normalMatrix[j][k] += jacobian[j] * jacobian[k];
+				}
+			}
+		}
+	}
+
+	return cost;
+}
+
+/**
+ *	@brief Solve (A + damping diag(A)) x = -b by Cholesky decomposition, using the lower
+ *	triangle of A.
+ *
+ *	@return int : 0 if success, 1 if the damped matrix is not positive definite
+ */
+static int
+solveDampedNormalEquations(
+	double       A[kSpectrumFitMaximumParameters][kSpectrumFitMaximumParameters],
+	const double * const b,
+	const double         damping,
+	const size_t         n,
+	double * const       x)
+{
+	double L[kSpectrumFitMaximumParameters][kSpectrumFitMaximumParameters];
+
+	for (size_t j = 0; j < n; j++)
+	{
+		double diagonal = A[j][j] * (1 + damping);
+
+		for (size_t k = 0; k < j; k++)
+		{
+			diagonal -= L[j][k] * L[j][k];
+		}
+
+		if (!(diagonal > 0))
+		{
+			return 1;
+		}
+
+		L[j][j] = sqrt(diagonal);
+		for (size_t i = j + 1; i < n; i++)
+		{
+			double value = A[i][j];
+
+			for (size_t k = 0; k < j; k++)
+			{
+				value -= L[i][k] * L[j][k];
+			}
+			L[i][j] = value / L[j][j];
+		}
+	}
+
+	/*
+	 *	Forward substitution L y = -b, then back substitution L^T x = y.
+	 */
+	for (size_t i = 0; i < n; i++)
+	{
+		double value = -b[i];
+
+		for (size_t k = 0; k < i; k++)
+		{
+			value -= L[i][k] * x[k];
+		}
+		x[i] = value / L[i][i];
+	}
+
+	for (size_t i = n; i-- > 0;)
+	{
+		double value = x[i];
+
+		for (size_t k = i + 1; k < n; k++)
+		{
+			value -= L[k][i] * x[k];
+		}
+		x[i] = value / L[i][i];
+	}
+
+	return 0;
+}
+
+/**
+ *	@brief Initial parameters from the spectral moments.
+ */
+static void
+warmStart(
+	const SpectrumModelType      model,
+	const WaveStatistics * const statistics,
+	const double                 maximumFrequency,
+	double * const               parameters)
+{
+	const double Hs = statistics->significantWaveHeight;
+	const double meanFrequency = statistics->moments.m1 / statistics->moments.m0;
+	const double fp = isfinite(statistics->peakPeriod) ? 1 / statistics->peakPeriod
+							    : meanFrequency;
+
+	parameters[0] = Hs;
+	parameters[1] = fp;
+
+	if (model == kSpectrumModelJONSWAP)
+	{
+		parameters[2] = kJONSWAPDefaultPeakEnhancement;
+	}
+	else if (model == kSpectrumModelOchiHubble)
+	{
+		/*
+		 *	Split the energy between a peaky swell at the spectral peak and a broader wind sea
+		 *	placed as far above the mean frequency as the peak is below it.
+		 */
+		parameters[0] = Hs / sqrt(2);
+		parameters[2] = 3;
+		parameters[3] = Hs / sqrt(2);
+		parameters[4] = meanFrequency > 1.1 * fp ? 2 * meanFrequency - fp : 1.5 * fp;
+		parameters[5] = 1;
+
+		if (parameters[4] > maximumFrequency)
+		{
+			parameters[4] = maximumFrequency;
+		}
+	}
+}
+
+int
+fitWaveSpectrum(
+	SpectrumFit * const     fit,
+	const SpectrumModelType model,
+	const float * const     spectrum,
+	const size_t            binCount,
+	const double            frequencyStep,
+	const double            densityScale)
+{
+	const size_t   parameterCount = spectrumModelParameterCount(model);
+	const double   maximumFrequency = (binCount - 1) * frequencyStep;
+	WaveStatistics statistics;
+	double         normalMatrix[kSpectrumFitMaximumParameters][kSpectrumFitMaximumParameters];
+	double         gradient[kSpectrumFitMaximumParameters];
+	double         lower[kSpectrumFitMaximumParameters];
+	double         upper[kSpectrumFitMaximumParameters];
+	double         damping = 1e-3;
+	double         cost;
+	size_t         validBinCount = 0;
+
+	for (size_t i = 1; i < binCount; i++)
+	{
+		validBinCount += spectrum[i] <= FLT_MAX;
+	}
+
+	fit->model = model;
+	fit->iterations = 0;
+	fit->isConverged = 0;
+
+	calculateWaveStatistics(&statistics, spectrum, binCount, frequencyStep, densityScale);
+	if (validBinCount <= parameterCount || !(statistics.moments.m0 > 0))
+	{
+		return 1;
+	}
+
+	warmStart(model, &statistics, maximumFrequency, fit->parameters);
+	parameterBounds(model, frequencyStep, maximumFrequency, lower, upper);
+	for (size_t j = 0; j < parameterCount; j++)
+	{
+		fit->parameters[j] = fmin(fmax(fit->parameters[j], lower[j]), upper[j]);
+	}
+	cost = evaluateCost(
+		model,
+		fit->parameters,
+		spectrum,
+		binCount,
+		frequencyStep,
+		densityScale,
+		normalMatrix,
+		gradient);
+
+	while (fit->iterations < kSpectrumFitMaximumIterations && !fit->isConverged)
+	{
+		double step[kSpectrumFitMaximumParameters];
+		double trial[kSpectrumFitMaximumParameters];
+		double trialCost;
+
+		fit->iterations++;
+
+		/*
+		 *	Hold parameters that sit on a bound the descent direction points beyond, so the
+		 *	remaining parameters still converge quickly.
+		 */
+		for (size_t j = 0; j < parameterCount; j++)
+		{
+			if ((fit->parameters[j] <= lower[j] && gradient[j] > 0) ||
+			    (fit->parameters[j] >= upper[j] && gradient[j] < 0))
+			{
+				gradient[j] = 0;
+				for (size_t k = 0; k < parameterCount; k++)
+				{
+					normalMatrix[j][k] = normalMatrix[k][j] = 0;
+				}
+				normalMatrix[j][j] = 1;
+			}
+		}
+
+		if (solveDampedNormalEquations(normalMatrix, gradient, damping, parameterCount, step))
+		{
+			damping *= 10;
+			continue;
+		}
+
+		memcpy(trial, fit->parameters, sizeof(trial));
+		for (size_t j = 0; j < parameterCount; j++)
+		{
+			trial[j] = fmin(fmax(trial[j] + step[j], lower[j]), upper[j]);
+		}
+
+		/*
+		 *	Once the step is negligible (e.g., pushing against a parameter bound), the fit is as
+		 *	good as it will get.
+		 */
+		{
+			double largestChange = 0;
+
+			for (size_t j = 0; j < parameterCount; j++)
+			{
+				largestChange = fmax(
+					largestChange,
+					fabs(trial[j] - fit->parameters[j]) / fabs(fit->parameters[j]));
+			}
+
+			if (largestChange <= kConvergenceTolerance)
+			{
+				fit->isConverged = 1;
+				break;
+			}
+		}
+
+		trialCost = evaluateCost(
+			model,
+			trial,
+			spectrum,
+			binCount,
+			frequencyStep,
+			densityScale,
+			NULL,
+			NULL);
+
+		if (trialCost < cost)
+		{
+			fit->isConverged = cost - trialCost <= kConvergenceTolerance * cost;
+			memcpy(fit->parameters, trial, sizeof(trial));
+			damping = fmax(damping / 3, 1e-12);
+			cost = evaluateCost(
+				model,
+				fit->parameters,
+				spectrum,
+				binCount,
+				frequencyStep,
+				densityScale,
+				normalMatrix,
+				gradient);
+		}
+		else
+		{
+			/*
+			 *	A step that cannot reduce the cost even with heavy damping means the fit has
+			 *	reached a minimum (possibly on a parameter bound).
+			 */
+			fit->isConverged = damping > 1e10;
+			damping *= 4;
+		}
+	}
+
+	fit->residual = sqrt(cost / validBinCount);
+
+	return 0;
+}
+
+typedef struct SpectrumFitWorker
+{
+	SpectrumFitTask * tasks;
+	size_t            taskCount;
+	size_t            first;
+	size_t            stride;
+	pthread_t         thread;
+} SpectrumFitWorker;
+
+static void *
+fitWorkerTasks(void * argument)
+{
+	SpectrumFitWorker * const worker = (SpectrumFitWorker *)argument;
+
+	for (size_t i = worker->first; i < worker->taskCount; i += worker->stride)
+	{
+		SpectrumFitTask * const task = &worker->tasks[i];
+
+		task->returnValue = fitWaveSpectrum(
+			&task->fit,
+			task->model,
+			task->spectrum,
+			task->binCount,
+			task->frequencyStep,
+			task->densityScale);
+	}
+
+	return NULL;
+}
+
+int
+fitWaveSpectra(SpectrumFitTask * const tasks, const size_t taskCount, size_t threadCount)
+{
+	SpectrumFitWorker workers[kSpectrumFitMaximumThreads];
+	int               isThreadRunning[kSpectrumFitMaximumThreads] = {0};
+	int               returnValue = 0;
+
+	if (threadCount > kSpectrumFitMaximumThreads)
+	{
+		threadCount = kSpectrumFitMaximumThreads;
+	}
+	if (threadCount > taskCount)
+	{
+		threadCount = taskCount;
+	}
+	if (threadCount == 0)
+	{
+		threadCount = 1;
+	}
+
+	for (size_t t = 0; t < threadCount; t++)
+	{
+		workers[t] = (SpectrumFitWorker){
+			.tasks = tasks,
+			.taskCount = taskCount,
+			.first = t,
+			.stride = threadCount,
+		};
+
+		/*
+		 *	The calling thread takes the first share of the tasks itself.
+		 */
+		if (t > 0)
+		{
+			isThreadRunning[t] =
+				pthread_create(&workers[t].thread, NULL, fitWorkerTasks, &workers[t]) == 0;
+		}
+	}
+
+	for (size_t t = 0; t < threadCount; t++)
+	{
+		if (!isThreadRunning[t])
+		{
+			fitWorkerTasks(&workers[t]);
+		}
+	}
+
+	for (size_t t = 0; t < threadCount; t++)
+	{
+		if (isThreadRunning[t])
+		{
+			pthread_join(workers[t].thread, NULL);
+		}
+	}
+
+	for (size_t i = 0; i < taskCount; i++)
+	{
+		returnValue |= tasks[i].returnValue;
+	}
+
+	return returnValue;
+}
+
+int
+parseSpectrumModelType(const char * const name, SpectrumModelType * const model)
+{
+	for (size_t i = 0; i < kSpectrumModelMaximum; i++)
+	{
+		if (strcmp(name, kSpectrumModelNames[i]) == 0)
+		{
+			*model = (SpectrumModelType)i;
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+const char *
+spectrumModelName(const SpectrumModelType model)
+{
+	return model < kSpectrumModelMaximum ? kSpectrumModelNames[model] : "unknown";
+}
+
+const char *
+spectrumModelParameterName(const SpectrumModelType model, const size_t index)
+{
+	return model < kSpectrumModelMaximum && index < spectrumModelParameterCount(model)
+		       ? kParameterNames[model][index]
+		       : "unknown";
+}
@@ -0,0 +1,164 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+typedef enum
+{
+	kSpectrumFitMaximumParameters = 6,
+	kSpectrumFitMaximumIterations = 100,
+	kSpectrumFitMaximumThreads = 64,
+} SpectrumFitConstants;
+
+typedef enum
+{
+	kSpectrumModelPiersonMoskowitz,
+	kSpectrumModelJONSWAP,
+	kSpectrumModelOchiHubble,
+	kSpectrumModelMaximum,
+} SpectrumModelType;
+
+/**
+ *	@brief Parameters of a parametric wave spectrum fitted to a measured spectrum.
+ *	@note Parameters are, in order, for Pierson-Moskowitz: Hs, fp; for JONSWAP: Hs, fp, gamma;
+ *	for Ochi-Hubble: Hs, fp and lambda of the first (lower frequency) component, then of the
+ *	second. Frequencies are in Hz.
+ *
+ */
+typedef struct SpectrumFit
+{
+	SpectrumModelType model;
+	double            parameters[kSpectrumFitMaximumParameters];
+	double            residual;
+	size_t            iterations;
+	int               isConverged;
+} SpectrumFit;
+
+/**
+ *	@brief One spectrum of a batch fitted by fitWaveSpectra().
+ *
+ */
+typedef struct SpectrumFitTask
+{
+	const float *     spectrum;
+	size_t            binCount;
+	double            frequencyStep;
+	double            densityScale;
+	SpectrumModelType model;
+	SpectrumFit       fit;
+	int               returnValue;
+} SpectrumFitTask;
+
+/**
+ *	@brief Get the number of parameters of a parametric wave spectrum.
+ *
+ *	@param model   : Spectrum model.
+ *	@return size_t : Number of parameters
+ */
+size_t
+spectrumModelParameterCount(const SpectrumModelType model);
+
+/**
+ *	@brief Evaluate a parametric wave spectrum.
+ *
+ *	@param model      : Spectrum model.
+ *	@param parameters : Pointer to the model parameters (see SpectrumFit).
+ *	@param frequency  : Frequency in Hz (> 0).
+ *	@return double    : One-sided spectral density
+ */
+double
+evaluateSpectrumModel(
+	const SpectrumModelType model,
+	const double * const    parameters,
+	const double            frequency);
+
+/**
+ *	@brief Fit a parametric wave spectrum to a measured spectrum by Levenberg-Marquardt
+ *	nonlinear least squares.
+ *	@note The fit starts from the significant wave height and peak frequency given by the
+ *	spectral moments, uses analytic Jacobians and stops after at most
+ *	kSpectrumFitMaximumIterations iterations. It does not allocate memory, so it can run
+ *	concurrently on many spectra (see fitWaveSpectra()). The 0 Hz bin and bins that are not
+ *	finite are ignored.
+ *
+ *	@param fit           : Pointer to SpectrumFit to store the fitted parameters.
+ *	@param model         : Spectrum model to fit.
+ *	@param spectrum      : Pointer to buffer containing the spectrum from 0 Hz.
+ *	@param binCount      : Number of bins (e.g., up to but excluding the Nyquist frequency).
+ *	@param frequencyStep : Frequency resolution of the spectrum in Hz.
+ *	@param densityScale  : Factor converting the spectrum bins to a one-sided spectral density.
+ *	@return int          : 0 if success, 1 if the spectrum has too few usable bins
+ */
+int
+fitWaveSpectrum(
+	SpectrumFit * const     fit,
+	const SpectrumModelType model,
+	const float * const     spectrum,
+	const size_t            binCount,
+	const double            frequencyStep,
+	const double            densityScale);
+
+/**
+ *	@brief Fit a batch of spectra in parallel.
+ *	@note Tasks are shared out between the threads in a fixed interleaved order. If a thread
+ *	cannot be created, its tasks are fitted on the calling thread.
+ *
+ *	@param tasks       : Pointer to array of tasks. Each task's fit and returnValue are set.
+ *	@param taskCount   : Number of tasks.
+ *	@param threadCount : Number of threads (at most kSpectrumFitMaximumThreads).
+ *	@return int        : 0 if every fit succeeded, 1 otherwise
+ */
+int
+fitWaveSpectra(SpectrumFitTask * const tasks, const size_t taskCount, size_t threadCount);
+
+/**
+ *	@brief Parse the name of a parametric wave spectrum.
+ *
+ *	@param name  : Model name ("pm", "jonswap" or "ochi-hubble").
+ *	@param model : Pointer to location to store the model.
+ *	@return int  : 0 if success, 1 if the name is not recognised
+ */
+int
+parseSpectrumModelType(const char * const name, SpectrumModelType * const model);
+
+/**
+ *	@brief Get the name of a parametric wave spectrum.
+ *
+ *	@param model        : Spectrum model.
+ *	@return const char* : Model name, as accepted by parseSpectrumModelType()
+ */
+const char *
+spectrumModelName(const SpectrumModelType model);
+
+/**
+ *	@brief Get the name of a parameter of a parametric wave spectrum.
+ *
+ *	@param model        : Spectrum model.
+ *	@param index        : Parameter index (see SpectrumFit).
+ *	@return const char* : Parameter name
+ */
+const char *
+spectrumModelParameterName(const SpectrumModelType model, const size_t index);
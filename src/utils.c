@@ -23,135 +23,238 @@
  */
 
 #include "utils.h"
-#include "integrate.h"
+#include "compressedInput.h"
+#include "csvParser.h"
+#include "fileMapping.h"
+#include "sampleFile.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-/**
- *	@brief Determine the size of array required to store values from a CSV file.
- *
- *	@param stream  : File stream to read from.
- *	@return size_t : Size of array required to store values read from the CSV file.
- */
-static size_t
-determineBufferSize(FILE * stream)
+int
+readSamplesFromFileToHeapBuffer(
+	const char * const         filePath,
+	const CountScaling * const scaling,
+	Buffer * const             buf,
+	InputFileInfo * const      info)
 {
-	float  buf;
-	int    fscanfResult;
-	size_t count = 0;
+	MappedFile      file;
+	CompressionType compression;
+	int             returnCode;
 
-	do
+	if (buf == NULL)
 	{
-		fscanfResult = fscanf(stream, "%f,", &buf);
-		count++;
-		if (count == 0)
-		{
-			/*
-			 *	Overflow
-			 */
-			break;
-		}
-	} while (fscanfResult != EOF && fscanfResult != 0);
+		printf("Error: null pointer passed to function "
+		       "readSamplesFromFileToHeapBuffer()\n");
+		return 1;
+	}
 
-	rewind(stream);
+	if (info != NULL)
+	{
+		info->samplePeriod = 0;
+		info->channelCount = 1;
+		info->isCountData = 0;
+		info->countScale = 1;
+		info->countOffset = 0;
+	}
 
-	return --count;
-}
+	if (mapFile(filePath, &file))
+	{
+		return 1;
+	}
 
-/**
- *	@brief Read the float values from the given CSV file and store them in the specified heap
- *	buffer.
- *
- *	@param stream : File stream to read from.
- *	@param buf    : Pointer to buffer to store values read from CSV file.
- *	@return int   : Return code (0 if successful, else 1)
- */
-static int
-getFloatsFromCSV(FILE * stream, Buffer * const buf)
-{
-	for (size_t i = 0; i < buf->size; i++)
+	compression = detectCompression(&file);
+	if (compression != kCompressionNone)
 	{
-		const int returnValue = fscanf(stream, "%f,", &(buf->heapPointer[i]));
-		if (returnValue == EOF || returnValue == 0)
+		returnCode = readCompressedSamples(&file, compression, scaling, buf, info);
+		unmapFile(&file);
+
+		if (returnCode != 0)
 		{
+			printf("Error: failed to read data from file at path '%s'\n", filePath);
 			return 1;
 		}
 	}
+	else if (isSampleFile(&file))
+	{
+		returnCode = readSampleFileChannel(&file, 0, scaling, buf, info);
+		unmapFile(&file);
+
+		if (returnCode != 0)
+		{
+			printf("Error: failed to read data from file at path '%s'\n", filePath);
+			return 1;
+		}
+	}
+	else
+	{
+		returnCode = parseFloatsFromCSV(file.data, file.size, buf);
+		unmapFile(&file);
+
+		if (returnCode != 0)
+		{
+			printf("Error: The program ran out of heap memory. Try reducing the amount of "
+			       "input data, or increasing the amount of available memory by selecting "
+			       "a different core.\n");
+			return 1;
+		}
+	}
+
+	if (buf->size == 0)
+	{
+		printf("Error: no data found in the specified file ('%s')\n", filePath);
+		return 1;
+	}
 
 	return 0;
 }
 
-void
-subtractMean(Buffer * const buf)
+int
+readColumnsFromFileToHeapBuffers(
+	const char * const         filePath,
+	const char * const * const selectors,
+	const size_t               selectorCount,
+	Buffer * const             columns,
+	InputFileInfo * const      info)
 {
-	float total = 0;
-	float mean;
+	MappedFile      file;
+	CompressionType compression;
+	int             returnCode = 0;
 
-	for (size_t i = 0; i < buf->size; i++)
+	if (info != NULL)
 	{
-		total += buf->heapPointer[i];
+		info->samplePeriod = 0;
+		info->channelCount = selectorCount;
+		info->isCountData = 0;
+		info->countScale = 1;
+		info->countOffset = 0;
+		for (size_t i = 0; i < kMaximumInputColumns; i++)
+		{
+			info->columnSpans[i] = 0;
+		}
 	}
 
-	mean = total / buf->size;
-
-	for (size_t i = 0; i < buf->size; i++)
+	for (size_t i = 0; i < selectorCount; i++)
 	{
-		buf->heapPointer[i] -= mean;
+		columns[i].heapPointer = NULL;
+		columns[i].size = 0;
 	}
-}
 
-int
-readFloatsFromFileToHeapBuffer(const char * const filePath, Buffer * const buf)
-{
-	int    returnCode;
-	FILE * stream = fopen(filePath, "r");
-
-	if (buf == NULL)
+	if (selectorCount > kMaximumInputColumns)
 	{
-		fclose(stream);
-		printf("Error: null pointer passed to function readFloatsToHeapBuffer()\n");
+		printf("Error: at most %d columns may be read from a file\n", kMaximumInputColumns);
 		return 1;
 	}
 
-	if (stream == NULL)
+	if (mapFile(filePath, &file))
 	{
-		printf("Error: could not open file at path '%s'\n", filePath);
 		return 1;
 	}
 
-	buf->size = determineBufferSize(stream);
+	compression = detectCompression(&file);
+	if (compression != kCompressionNone)
+	{
+		MappedFile decompressed;
 
-	if (buf->size == 0)
+		returnCode = decompressToMemory(&file, compression, &decompressed);
+		unmapFile(&file);
+
+		if (returnCode != 0)
+		{
+			printf("Error: failed to read data from file at path '%s'\n", filePath);
+			return 1;
+		}
+
+		file = decompressed;
+	}
+
+	if (isSampleFile(&file))
 	{
-		fclose(stream);
-		printf("Error: no data found in the specified file ('%s')\n", filePath);
-		return 1;
+		for (size_t i = 0; i < selectorCount && returnCode == 0; i++)
+		{
+			size_t channelIndex;
+
+			if (findSampleFileChannel(&file, selectors[i], &channelIndex))
+			{
+				printf("Error: no channel '%s' in file at path '%s'\n",
+				       selectors[i],
+				       filePath);
+				returnCode = 1;
+			}
+			else
+			{
+				returnCode = readSampleFileChannel(
+					&file,
+					channelIndex,
+					NULL,
+					&columns[i],
+					info);
+			}
+
+			if (returnCode == 0 && info != NULL && columns[i].size > 0)
+			{
+				info->columnSpans[i] =
+					(double)columns[i].heapPointer[columns[i].size - 1] -
+					columns[i].heapPointer[0];
+			}
+		}
+	}
+	else
+	{
+		returnCode = parseColumnsFromCSV(
+			file.data,
+			file.size,
+			selectors,
+			selectorCount,
+			columns,
+			info != NULL ? info->columnSpans : NULL);
 	}
 
-	buf->heapPointer = (float *)calloc(buf->size, sizeof(float));
+	unmapFile(&file);
 
-	if (buf->heapPointer == NULL)
+	if (returnCode == 0 && (selectorCount == 0 || columns[0].size == 0))
 	{
-		fclose(stream);
-		printf("Error: The program ran out of heap memory. Try reducing the amount of "
-		       "input data, or increasing the amount of available memory by selecting a "
-		       "different core.\n");
-		return 1;
+		printf("Error: no data found in the specified file ('%s')\n", filePath);
+		returnCode = 1;
 	}
 
-	returnCode = getFloatsFromCSV(stream, buf);
-
 	if (returnCode != 0)
 	{
-		fclose(stream);
+		for (size_t i = 0; i < selectorCount; i++)
+		{
+			freeHeapBuffer(&columns[i]);
+			columns[i].heapPointer = NULL;
+			columns[i].size = 0;
+		}
 		printf("Error: failed to read data from file at path '%s'\n", filePath);
-		return 1;
 	}
 
-	fclose(stream);
+	return returnCode;
+}
 
-	return 0;
+double
+calculateMeanTimestep(const double timeSpan, const size_t timestampCount)
+{
+	if (timestampCount < 2)
+	{
+		return 0;
+	}
+
+	return timeSpan / (timestampCount - 1);
+}
+
+uint64_t
+fnv1aHash(uint64_t hash, const void * const data, const size_t size)
+{
+	const uint64_t              prime = 0x100000001B3ULL;
+	const unsigned char * const bytes = (const unsigned char *)data;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash = (hash ^ bytes[i]) * prime;
+	}
+
+	return hash;
 }
 
 int
@@ -183,30 +286,3 @@ freeHeapBuffer(Buffer * const buf)
 {
 	free(buf->heapPointer);
 }
-
-void
-numericalIntegration(Buffer * const timeSeriesData, const float dt)
-{
-	State newState;
-	State oldState = {
-		.position = 0,
-		.speed = 0,
-	};
-	float newAcceleration = timeSeriesData->heapPointer[0];
-	float oldAcceleration = 0;
-
-	for (size_t i = 0; i < timeSeriesData->size; i++)
-	{
-		newAcceleration = timeSeriesData->heapPointer[i];
-
-		integrate(&newState, &oldState, newAcceleration, oldAcceleration, dt);
-
-		oldAcceleration = timeSeriesData->heapPointer[i];
-		timeSeriesData->heapPointer[i] = newState.position;
-
-		oldState.position = newState.position;
-		oldState.speed = newState.speed;
-	}
-
-	subtractMean(timeSeriesData);
-}
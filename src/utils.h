@@ -25,6 +25,14 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
+
+static const uint64_t kFNV1aOffsetBasis = 0xCBF29CE484222325ULL;
+
+typedef enum
+{
+	kMaximumInputColumns = 4,
+} UtilsConstants;
 
 /**
  *	@brief Buffer array stored in the heap.
@@ -37,22 +45,93 @@ typedef struct Buffer
 } Buffer;
 
 /**
- *	@brief Subtract the mean value of a Buffer from all elements in the Buffer.
+ *	@brief Metadata read from an input file.
+ *	@note Fields that the file format cannot provide (e.g., the sample period of a CSV file)
+ *	are zero.
  *
- *	@param buf : Pointer to Buffer to modify.
  */
-void
-subtractMean(Buffer * const buf);
+typedef struct InputFileInfo
+{
+	double samplePeriod;
+	size_t channelCount;
+	int    isCountData;
+	float  countScale;
+	float  countOffset;
+	/*
+	 *	Last minus first value of each selected column (multi-column reads only), in double
+	 *	precision so that the span of e.g. Unix epoch timestamps is not lost to rounding
+	 */
+	double columnSpans[kMaximumInputColumns];
+} InputFileInfo;
+
+/**
+ *	@brief Scale and offset used to convert raw integer counts to measurement units.
+ *	@note A NAN field means the value from the input file header is used.
+ *
+ */
+typedef struct CountScaling
+{
+	float scale;
+	float offset;
+} CountScaling;
 
 /**
- *	@brief Read floats from a CSV file to a heap Buffer.
+ *	@brief Read floats from a CSV file or binary sample file to a heap Buffer, along with any
+ *	metadata the file provides.
  *
- *	@param filePath : Path to CSV file.
+ *	@param filePath : Path to CSV file or binary sample file.
+ *	@param scaling  : Pointer to overrides for the scaling of raw integer counts (may be NULL).
  *	@param buf      : Pointer to Buffer to store information read from file.
+ *	@param info     : Pointer to location to store file metadata (may be NULL).
  *	@return int     : Return code (0 if OK, 1 if error encountered)
  */
 int
-readFloatsFromFileToHeapBuffer(const char * const filePath, Buffer * const buf);
+readSamplesFromFileToHeapBuffer(
+	const char * const         filePath,
+	const CountScaling * const scaling,
+	Buffer * const             buf,
+	InputFileInfo * const      info);
+
+/**
+ *	@brief Read selected columns of a multi-column CSV file, or selected channels of a binary
+ *	sample file, to heap Buffers. A CSV file is parsed only once, however many columns are read.
+ *
+ *	@param filePath      : Path to CSV file or binary sample file.
+ *	@param selectors     : Array of column (channel) selectors: an index counting from 0, or a
+ *	name from the CSV header line (binary sample file channel names).
+ *	@param selectorCount : Number of column selectors (at most kMaximumInputColumns).
+ *	@param columns       : Array of selectorCount Buffers to store the columns.
+ *	@param info          : Pointer to location to store file metadata (may be NULL).
+ *	@return int          : Return code (0 if OK, 1 if error encountered)
+ */
+int
+readColumnsFromFileToHeapBuffers(
+	const char * const         filePath,
+	const char * const * const selectors,
+	const size_t               selectorCount,
+	Buffer * const             columns,
+	InputFileInfo * const      info);
+
+/**
+ *	@brief Calculate the mean time between successive timestamps.
+ *
+ *	@param timeSpan       : Last minus first timestamp (see InputFileInfo::columnSpans).
+ *	@param timestampCount : Number of timestamps.
+ *	@return double        : Mean timestep, or 0 if there are fewer than two timestamps.
+ */
+double
+calculateMeanTimestep(const double timeSpan, const size_t timestampCount);
+
+/**
+ *	@brief Update a 64-bit FNV-1a hash with a block of bytes.
+ *
+ *	@param hash      : Hash so far (kFNV1aOffsetBasis for the first block).
+ *	@param data      : Pointer to bytes to hash.
+ *	@param size      : Number of bytes.
+ *	@return uint64_t : Updated hash
+ */
+uint64_t
+fnv1aHash(uint64_t hash, const void * const data, const size_t size);
 
 /**
  *	@brief Extend the size of a heap buffer.
@@ -71,12 +150,3 @@ extendHeapBuffer(Buffer * const buf, const size_t newSize);
  */
 void
 freeHeapBuffer(Buffer * const buf);
-
-/**
- *	@brief Perform double integration to convert acceleration values to position values.
- *
- *	@param timeSeriesData : Pointer to Buffer containing time series acceleration data.
- *	@param dt             : Timestep value (time between successive time series data points).
- */
-void
-numericalIntegration(Buffer * const timeSeriesData, const float dt);
@@ -24,43 +24,617 @@
 
 #include "waveEstimation.h"
 #include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-static void
-elementWiseDivide(
-	float * const       result,
-	const float * const numerator,
-	const float * const denominator,
+void
+calculateRAO(
+	float * const       RAO,
+	const float * const heaveSpectrum,
+	const float * const waveSpectrum,
 	const size_t        N)
 {
-	for (size_t i = 0; i < N; i++)
+	spectrumDivide(RAO, heaveSpectrum, waveSpectrum, N);
+}
+
+void
+calculateWaveEnergySpectrum(
+	float * const       waveSpectrum,
+	const float * const heaveSpectrum,
+	const float * const RAO,
+	const size_t        N)
+{
+	spectrumDivide(waveSpectrum, heaveSpectrum, RAO, N);
+}
+
+/**
+ *	@brief Mirror the bins below the Nyquist frequency into the bins above it.
+ */
+static void
+mirrorSpectrum(float * const spectrum, const size_t N)
+{
+	for (size_t i = N / 2 + 1; i < N; i++)
 	{
-		if (denominator[i] == 0)
+		spectrum[i] = spectrum[N - i];
+	}
+}
+
+/**
+ *	@brief Solve a small dense linear system by Gaussian elimination with partial pivoting.
+ *	@note The matrix and right hand side are overwritten.
+ *
+ *	@return int : 0 if success, 1 if the matrix is singular
+ */
+static int
+solveLinearSystem(
+	double matrix[kRAOModelCoefficientCount][kRAOModelCoefficientCount],
+	double vector[kRAOModelCoefficientCount],
+	double solution[kRAOModelCoefficientCount])
+{
+	const size_t n = kRAOModelCoefficientCount;
+
+	for (size_t column = 0; column < n; column++)
+	{
+		size_t pivot = column;
+
+		for (size_t row = column + 1; row < n; row++)
 		{
-			result[i] = INFINITY;
+			if (fabs(matrix[row][column]) > fabs(matrix[pivot][column]))
+			{
+				pivot = row;
+			}
 		}
-		else
+
+		if (matrix[pivot][column] == 0)
+		{
+			return 1;
+		}
+
+		if (pivot != column)
 		{
-			result[i] = numerator[i] / denominator[i];
+			double swap[kRAOModelCoefficientCount];
+			double swapValue = vector[pivot];
+
+			memcpy(swap, matrix[pivot], sizeof(swap));
+			memcpy(matrix[pivot], matrix[column], sizeof(swap));
+			memcpy(matrix[column], swap, sizeof(swap));
+			vector[pivot] = vector[column];
+			vector[column] = swapValue;
+		}
+
+		for (size_t row = column + 1; row < n; row++)
+		{
+			const double factor = matrix[row][column] / matrix[column][column];
+
+			for (size_t k = column; k < n; k++)
+			{
+				matrix[row][k] -= factor * matrix[column][k];
+			}
+			vector[row] -= factor * vector[column];
 		}
 	}
+
+	for (size_t row = n; row-- > 0;)
+	{
+		double total = vector[row];
+
+		for (size_t k = row + 1; k < n; k++)
+		{
+			total -= matrix[row][k] * solution[k];
+		}
+		solution[row] = total / matrix[row][row];
+	}
+
+	return 0;
+}
+
+int
+fitRAOModel(
+	RAOModel * const    model,
+	const float * const RAO,
+	const size_t        N,
+	const float         frequencyStep)
+{
+	double       normalMatrix[kRAOModelCoefficientCount][kRAOModelCoefficientCount] = {{0}};
+	double       normalVector[kRAOModelCoefficientCount] = {0};
+	double       solution[kRAOModelCoefficientCount];
+	const size_t nyquistIndex = N / 2;
+	size_t       usableBinCount = 0;
+
+	if (nyquistIndex == 0)
+	{
+		return 1;
+	}
+
+	/*
+	 *	Normalise frequencies to the Nyquist frequency to keep the normal equations well
+	 *	conditioned.
+	 */
+	model->referenceFrequency = frequencyStep * nyquistIndex;
+
+	for (size_t i = 0; i <= nyquistIndex; i++)
+	{
+		const double x = (double)i / nyquistIndex;
+		const double x2 = x * x;
+		double       row[kRAOModelCoefficientCount];
+
+		if (!isfinite(RAO[i]) || !(RAO[i] > 0))
+		{
+			continue;
+		}
+
+		row[0] = RAO[i];
+		row[1] = RAO[i] * x2;
+		row[2] = RAO[i] * x2 * x2;
+
+		for (size_t j = 0; j < kRAOModelCoefficientCount; j++)
+		{
+			for (size_t k = 0; k < kRAOModelCoefficientCount; k++)
+			{
+				normalMatrix[j][k] += row[j] * row[k];
+			}
+			normalVector[j] += row[j];
+		}
+		usableBinCount++;
+	}
+
+	if (usableBinCount < kRAOModelCoefficientCount ||
+	    solveLinearSystem(normalMatrix, normalVector, solution))
+	{
+		return 1;
+	}
+
+	for (size_t j = 0; j < kRAOModelCoefficientCount; j++)
+	{
+		model->coefficients[j] = solution[j];
+	}
+
+	return 0;
 }
 
 void
-calculateRAO(
-	float * const       RAO,
-	const float * const heaveSpectrum,
-	const float * const waveSpectrum,
-	const size_t        N)
+evaluateRAOModel(
+	float * const          RAO,
+	const RAOModel * const model,
+	const size_t           N,
+	const float            frequencyStep)
+{
+	const float  c0 = model->coefficients[0];
+	const float  c1 = model->coefficients[1];
+	const float  c2 = model->coefficients[2];
+	const float  xStep = frequencyStep / model->referenceFrequency;
+	const size_t nyquistIndex = N / 2;
+
+	for (size_t i = 0; i <= nyquistIndex; i++)
+	{
+		const float x = xStep * i;
+		const float x2 = x * x;
+		const float inverseRAO = c0 + x2 * (c1 + x2 * c2);
+
+		RAO[i] = inverseRAO > 0 ? 1 / inverseRAO : INFINITY;
+	}
+
+	mirrorSpectrum(RAO, N);
+}
+
+static float
+finiteOr(const float value, const float fallback)
 {
-	elementWiseDivide(RAO, heaveSpectrum, waveSpectrum, N);
+	return isfinite(value) ? value : fallback;
 }
 
 void
-calculateWaveEnergySpectrum(
-	float * const       waveSpectrum,
+interpolateRAO(
+	float * const           RAO,
+	const size_t            N,
+	const double            frequencyStep,
+	const float * const     sourceRAO,
+	const size_t            sourceN,
+	const double            sourceFrequencyStep,
+	const RAOResamplingType type)
+{
+	const size_t nyquistIndex = N / 2;
+	const size_t sourceNyquistIndex = sourceN / 2;
+	const double step = frequencyStep / sourceFrequencyStep;
+
+	for (size_t i = 0; i <= nyquistIndex; i++)
+	{
+		const double position = step * i;
+		const size_t k = (size_t)position;
+		float        fraction;
+		float        p1;
+		float        p2;
+
+		if (position > sourceNyquistIndex)
+		{
+			/*
+			 *	The RAO was not characterised at this frequency.
+			 */
+			RAO[i] = INFINITY;
+			continue;
+		}
+		fraction = position - k;
+		p1 = sourceRAO[k];
+		p2 = sourceRAO[(k + 1) % sourceN];
+
+		if (fraction == 0)
+		{
+			RAO[i] = p1;
+		}
+		else if (type == kRAOResamplingCubic && isfinite(p1) && isfinite(p2))
+		{
+			/*
+			 *	The two-sided source spectrum is periodic, so neighbours wrap around.
+			 */
+			const float p0 = finiteOr(sourceRAO[(k + sourceN - 1) % sourceN], p1);
+			const float p3 = finiteOr(sourceRAO[(k + 2) % sourceN], p2);
+			const float lower = fminf(fminf(p0, p1), fminf(p2, p3));
+			const float upper = fmaxf(fmaxf(p0, p1), fmaxf(p2, p3));
+			const float value =
+				p1 + 0.5f * fraction *
+					     (p2 - p0 +
+					      fraction * (2 * p0 - 5 * p1 + 4 * p2 - p3 +
+							  fraction * (3 * (p1 - p2) + p3 - p0)));
+
+			RAO[i] = fminf(fmaxf(value, lower), upper);
+		}
+		else
+		{
+			/*
+			 *	This form keeps an infinite RAO next to a finite one infinite (not NaN).
+			 */
+			RAO[i] = (1 - fraction) * p1 + fraction * p2;
+		}
+	}
+
+	mirrorSpectrum(RAO, N);
+}
+
+int
+parseRAOInterpolationType(const char * const name, RAOResamplingType * const type)
+{
+	if (strcmp(name, "none") == 0)
+	{
+		*type = kRAOResamplingNone;
+		return 0;
+	}
+
+	if (strcmp(name, "linear") == 0)
+	{
+		*type = kRAOResamplingLinear;
+		return 0;
+	}
+
+	if (strcmp(name, "cubic") == 0)
+	{
+		*type = kRAOResamplingCubic;
+		return 0;
+	}
+
+	return 1;
+}
+
+static double
+divideOrInfinity(const double numerator, const double denominator)
+{
+	return denominator == 0 ? INFINITY : numerator / denominator;
+}
+
+int
+estimateRAOWelch(
+	float * const                      RAO,
+	float * const                      coherence,
+	const float * const                heave,
+	const float * const                waveElevation,
+	const size_t                       sampleCount,
+	const RAOEstimatorSettings * const settings)
+{
+	const size_t L = settings->segmentSize;
+	const size_t hop = L / 2 > 0 ? L / 2 : 1;
+	const size_t segmentCount = sampleCount > L ? 1 + (sampleCount - L) / hop : 1;
+	const size_t binCount = L / 2 + 1;
+	Complex *    z = (Complex *)malloc(L * sizeof(Complex));
+	Complex *    Z = (Complex *)malloc(L * sizeof(Complex));
+	double *     Sxx = (double *)calloc(binCount, sizeof(double));
+	double *     Syy = (double *)calloc(binCount, sizeof(double));
+	double *     SxyReal = (double *)calloc(binCount, sizeof(double));
+	double *     SxyImaginary = (double *)calloc(binCount, sizeof(double));
+	int          returnValue = 0;
+
+	if (z == NULL || Z == NULL || Sxx == NULL || Syy == NULL || SxyReal == NULL ||
+	    SxyImaginary == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		returnValue = 1;
+		goto RETURN;
+	}
+
+	for (size_t segment = 0; segment < segmentCount; segment++)
+	{
+		const size_t start = segment * hop;
+		const size_t length = sampleCount - start < L ? sampleCount - start : L;
+
+		/*
+		 *	Pack elevation and heave into the real and imaginary parts of one FFT input.
+		 */
+		for (size_t n = 0; n < L; n++)
+		{
+			const float window = segmentCount > 1 ? windowCoefficient(kWindowHann, n, L) : 1;
+
+			z[n].real = n < length ? window * waveElevation[start + n] : 0;
+			z[n].imaginary = n < length ? window * heave[start + n] : 0;
+		}
+
+		complexFFT(Z, z, L);
+
+		/*
+		 *	Separate the spectra of the two real series: X = (Z[k] + conj(Z[L - k])) / 2 and
+		 *	Y = (Z[k] - conj(Z[L - k])) / 2i.
+		 */
+		for (size_t k = 0; k < binCount; k++)
+		{
+			const Complex a = Z[k];
+			const Complex b = Z[(L - k) % L];
+			const double  XReal = 0.5 * (a.real + b.real);
+			const double  XImaginary = 0.5 * (a.imaginary - b.imaginary);
+			const double  YReal = 0.5 * (a.imaginary + b.imaginary);
+			const double  YImaginary = -0.5 * (a.real - b.real);
+
+			Sxx[k] += XReal * XReal + XImaginary * XImaginary;
+			Syy[k] += YReal * YReal + YImaginary * YImaginary;
+			SxyReal[k] += XReal * YReal + XImaginary * YImaginary;
+			SxyImaginary[k] += XReal * YImaginary - XImaginary * YReal;
+		}
+	}
+
+	for (size_t k = 0; k < binCount; k++)
+	{
+		const double crossPower = SxyReal[k] * SxyReal[k] + SxyImaginary[k] * SxyImaginary[k];
+		const double autoPower = Sxx[k] * Syy[k];
+		const double binCoherence = autoPower > 0 ? crossPower / autoPower : 0;
+		double       value;
+
+		switch (settings->estimator)
+		{
+		case kRAOEstimatorH1:
+			value = divideOrInfinity(crossPower, Sxx[k] * Sxx[k]);
+			break;
+		case kRAOEstimatorH2:
+			value = divideOrInfinity(Syy[k] * Syy[k], crossPower);
+			break;
+		case kRAOEstimatorSpectralRatio:
+		default:
+			value = divideOrInfinity(Syy[k], Sxx[k]);
+			break;
+		}
+
+		RAO[k] = binCoherence < settings->minimumCoherence ? INFINITY : value;
+		if (coherence != NULL)
+		{
+			coherence[k] = binCoherence;
+		}
+	}
+
+	mirrorSpectrum(RAO, L);
+	if (coherence != NULL)
+	{
+		mirrorSpectrum(coherence, L);
+	}
+
+RETURN:
+	free(z);
+	free(Z);
+	free(Sxx);
+	free(Syy);
+	free(SxyReal);
+	free(SxyImaginary);
+	return returnValue;
+}
+
+int
+parseRAOEstimatorType(const char * const name, RAOEstimatorType * const type)
+{
+	if (strcmp(name, "ratio") == 0)
+	{
+		*type = kRAOEstimatorSpectralRatio;
+		return 0;
+	}
+
+	if (strcmp(name, "h1") == 0)
+	{
+		*type = kRAOEstimatorH1;
+		return 0;
+	}
+
+	if (strcmp(name, "h2") == 0)
+	{
+		*type = kRAOEstimatorH2;
+		return 0;
+	}
+
+	return 1;
+}
+
+/**
+ *	@brief Find the k-th smallest value (Hoare's selection), partially reordering the values.
+ */
+static float
+selectKthSmallest(float * const values, const size_t count, const size_t k)
+{
+	size_t left = 0;
+	size_t right = count - 1;
+
+	while (left < right)
+	{
+		const float pivot = values[left + (right - left) / 2];
+		size_t      i = left;
+		size_t      j = right;
+
+		while (i <= j)
+		{
+			while (values[i] < pivot)
+			{
+				i++;
+			}
+			while (values[j] > pivot)
+			{
+				j--;
+			}
+			if (i <= j)
+			{
+				const float temporary = values[i];
+
+				values[i] = values[j];
+				values[j] = temporary;
+				i++;
+				if (j == 0)
+				{
+					break;
+				}
+				j--;
+			}
+		}
+
+		if (k <= j)
+		{
+			right = j;
+		}
+		else if (k >= i)
+		{
+			left = i;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	return values[k];
+}
+
+int
+estimateNoiseFloor(float * const noiseFloor, const float * const spectrum, const size_t N)
+{
+	const size_t binCount = N / 2;
+	float *      values;
+
+	if (binCount == 0)
+	{
+		*noiseFloor = 0;
+		return 0;
+	}
+
+	values = (float *)malloc(binCount * sizeof(float));
+	if (values == NULL)
+	{
+		printf("Error: The program ran out of heap memory. Try reducing the amount of "
+		       "input data, or increasing the amount of available memory by selecting a "
+		       "different core.\n");
+		return 1;
+	}
+
+	memcpy(values, &spectrum[1], binCount * sizeof(float));
+	*noiseFloor = selectKthSmallest(values, binCount, binCount / 2);
+	free(values);
+
+	return 0;
+}
+
+float
+chooseRegularisation(
 	const float * const heaveSpectrum,
 	const float * const RAO,
-	const size_t        N)
+	const size_t        N,
+	const float         noiseFloor)
+{
+	double signalPower = 0;
+	double transferSum = 0;
+
+	for (size_t i = 0; i < N; i++)
+	{
+		if (isfinite(RAO[i]) && RAO[i] > 0)
+		{
+			signalPower += fmax(heaveSpectrum[i] - noiseFloor, 0);
+			transferSum += RAO[i];
+		}
+	}
+
+	if (signalPower == 0)
+	{
+		return INFINITY;
+	}
+
+	return noiseFloor / (signalPower / transferSum);
+}
+
+int
+calculateRegularisedWaveEnergySpectrum(
+	float * const                       waveSpectrum,
+	const float * const                 heaveSpectrum,
+	const float * const                 RAO,
+	const size_t                        N,
+	const DeconvolutionSettings * const settings,
+	float * const                       regularisation)
 {
-	elementWiseDivide(waveSpectrum, heaveSpectrum, RAO, N);
+	float lambda = settings->regularisation;
+
+	if (settings->type != kDeconvolutionExact && lambda == 0)
+	{
+		float noiseFloor;
+
+		if (estimateNoiseFloor(&noiseFloor, heaveSpectrum, N))
+		{
+			return 1;
+		}
+		lambda = chooseRegularisation(heaveSpectrum, RAO, N, noiseFloor);
+	}
+
+	switch (settings->type)
+	{
+	case kDeconvolutionFloor:
+		spectrumFlooredDivide(waveSpectrum, heaveSpectrum, RAO, sqrtf(lambda), N);
+		break;
+	case kDeconvolutionTikhonov:
+		spectrumRegularisedDivide(waveSpectrum, heaveSpectrum, RAO, lambda, N);
+		break;
+	case kDeconvolutionExact:
+	default:
+		lambda = 0;
+		spectrumDivide(waveSpectrum, heaveSpectrum, RAO, N);
+		break;
+	}
+
+	if (regularisation != NULL)
+	{
+		*regularisation = lambda;
+	}
+
+	return 0;
+}
+
+int
+parseDeconvolutionType(const char * const name, DeconvolutionType * const type)
+{
+	if (strcmp(name, "exact") == 0)
+	{
+		*type = kDeconvolutionExact;
+		return 0;
+	}
+
+	if (strcmp(name, "floor") == 0)
+	{
+		*type = kDeconvolutionFloor;
+		return 0;
+	}
+
+	if (strcmp(name, "tikhonov") == 0)
+	{
+		*type = kDeconvolutionTikhonov;
+		return 0;
+	}
+
+	return 1;
 }
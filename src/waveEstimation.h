@@ -24,8 +24,76 @@
 
 #pragma once
 
+#include "signalProcessing.h"
 #include <stddef.h>
 
+typedef enum
+{
+	kRAOModelCoefficientCount = 3,
+} WaveEstimationConstants;
+
+typedef enum
+{
+	kRAOResamplingNone,
+	kRAOResamplingLinear,
+	kRAOResamplingCubic,
+	kRAOResamplingParametric,
+	kRAOResamplingMaximum,
+} RAOResamplingType;
+
+typedef enum
+{
+	kRAOEstimatorSpectralRatio,
+	kRAOEstimatorH1,
+	kRAOEstimatorH2,
+	kRAOEstimatorMaximum,
+} RAOEstimatorType;
+
+typedef enum
+{
+	kDeconvolutionExact,
+	kDeconvolutionFloor,
+	kDeconvolutionTikhonov,
+	kDeconvolutionMaximum,
+} DeconvolutionType;
+
+/**
+ *	@brief How the heave spectrum is divided by the RAO.
+ *
+ */
+typedef struct DeconvolutionSettings
+{
+	DeconvolutionType type;
+	/*
+	 *	Tikhonov regularisation (in squared RAO units), or 0 to choose it from the noise floor
+	 *	of the heave spectrum.
+	 */
+	float regularisation;
+} DeconvolutionSettings;
+
+/**
+ *	@brief Settings of the Welch averaged RAO estimator.
+ *
+ */
+typedef struct RAOEstimatorSettings
+{
+	RAOEstimatorType estimator;
+	size_t           segmentSize;
+	float            minimumCoherence;
+} RAOEstimatorSettings;
+
+/**
+ *	@brief Parametric RAO of a second order system, 1 / RAO(f) = c0 + c1 x^2 + c2 x^4 with
+ *	x = f / referenceFrequency (e.g., c0 = c2 = 1 and c1 = 0 for a second order Butterworth
+ *	filter with its cutoff at the reference frequency).
+ *
+ */
+typedef struct RAOModel
+{
+	float coefficients[kRAOModelCoefficientCount];
+	float referenceFrequency;
+} RAOModel;
+
 /**
  *	@brief Calculate RAO from vessel characterisation measurements.
  *
@@ -57,3 +125,180 @@ calculateWaveEnergySpectrum(
 	const float * const heaveSpectrum,
 	const float * const RAO,
 	const size_t        N);
+
+/**
+ *	@brief Fit a parametric RAO model to an RAO characteristic.
+ *	@note The model is fitted by linear least squares on the relative error
+ *	RAO(f) (c0 + c1 x^2 + c2 x^4) - 1, over bins from 0 Hz up to the Nyquist frequency. Bins where
+ *	the RAO is not finite and positive are skipped.
+ *
+ *	@param model         : Pointer to model to store the fitted parameters.
+ *	@param RAO           : Pointer to buffer containing RAO characteristic.
+ *	@param N             : Number of elements in the RAO buffer (the FFT size).
+ *	@param frequencyStep : Frequency resolution of the RAO characteristic in Hz.
+ *	@return int          : 0 if success, 1 if there are too few usable bins to fit the model
+ */
+int
+fitRAOModel(
+	RAOModel * const    model,
+	const float * const RAO,
+	const size_t        N,
+	const float         frequencyStep);
+
+/**
+ *	@brief Evaluate a parametric RAO model on the frequency grid of an FFT.
+ *	@note Bins above the Nyquist frequency hold the mirror image of those below it, as in a
+ *	power spectrum. Frequencies where the model is not positive map to an infinite RAO.
+ *
+ *	@param RAO           : Pointer to buffer to store RAO characteristic.
+ *	@param model         : Pointer to fitted model.
+ *	@param N             : Number of elements in the RAO buffer (the FFT size).
+ *	@param frequencyStep : Frequency resolution of the FFT in Hz.
+ */
+void
+evaluateRAOModel(
+	float * const          RAO,
+	const RAOModel * const model,
+	const size_t           N,
+	const float            frequencyStep);
+
+/**
+ *	@brief Interpolate an RAO characteristic onto a different frequency grid.
+ *	@note The two grids may differ in both FFT size and sample rate. Cubic interpolation uses
+ *	Catmull-Rom splines, limited to the range of the four neighbouring values so that it never
+ *	overshoots to a negative RAO. Frequencies above the Nyquist frequency of the source get an
+ *	infinite RAO, so that they drop out of the wave spectrum. Bins above the Nyquist frequency
+ *	hold the mirror image of those below it, as in a power spectrum.
+ *
+ *	@param RAO                 : Pointer to buffer to store interpolated RAO characteristic.
+ *	@param N                   : Number of elements in the interpolated RAO buffer (the FFT
+ *	size).
+ *	@param frequencyStep       : Frequency resolution of the interpolated RAO in Hz.
+ *	@param sourceRAO           : Pointer to buffer containing RAO characteristic.
+ *	@param sourceN             : Number of elements in the source RAO buffer (the FFT size).
+ *	@param sourceFrequencyStep : Frequency resolution of the source RAO in Hz.
+ *	@param type                : kRAOResamplingLinear or kRAOResamplingCubic.
+ */
+void
+interpolateRAO(
+	float * const           RAO,
+	const size_t            N,
+	const double            frequencyStep,
+	const float * const     sourceRAO,
+	const size_t            sourceN,
+	const double            sourceFrequencyStep,
+	const RAOResamplingType type);
+
+/**
+ *	@brief Parse the name of an RAO interpolation scheme.
+ *
+ *	@param name : Scheme name ("none", "linear" or "cubic").
+ *	@param type : Pointer to location to store the scheme.
+ *	@return int : 0 if success, 1 if the name is not recognised
+ */
+int
+parseRAOInterpolationType(const char * const name, RAOResamplingType * const type);
+
+/**
+ *	@brief Estimate the RAO from Welch averaged auto- and cross-spectra of wave elevation
+ *	(input) and heave displacement (output) measurements.
+ *	@note When the record spans more than one segment, segments overlap by half and are Hann
+ *	windowed. Both series share one complex FFT per segment. With auto-spectra Sxx, Syy and
+ *	cross-spectrum Sxy, the RAO is Syy / Sxx (spectral ratio), |H1|^2 = |Sxy|^2 / Sxx^2 or
+ *	|H2|^2 = Syy^2 / |Sxy|^2, and the coherence is |Sxy|^2 / (Sxx Syy). The coherence of a
+ *	single segment is always 1. Bins with coherence below the minimum get an infinite RAO, so
+ *	that they drop out of the wave spectrum.
+ *
+ *	@param RAO           : Pointer to buffer to store RAO characteristic (segmentSize elements).
+ *	@param coherence     : Pointer to buffer to store coherence (segmentSize elements, may be
+ *	NULL).
+ *	@param heave         : Pointer to buffer containing heave displacement measurements.
+ *	@param waveElevation : Pointer to buffer containing wave elevation measurements.
+ *	@param sampleCount   : Number of measurements in each buffer.
+ *	@param settings      : Pointer to estimator settings. The segment size must be a power of
+ *	two. Records shorter than one segment are zero padded.
+ *	@return int          : 0 if success, 1 if error encountered
+ */
+int
+estimateRAOWelch(
+	float * const                      RAO,
+	float * const                      coherence,
+	const float * const                heave,
+	const float * const                waveElevation,
+	const size_t                       sampleCount,
+	const RAOEstimatorSettings * const settings);
+
+/**
+ *	@brief Parse the name of an RAO estimator.
+ *
+ *	@param name : Estimator name ("ratio", "h1" or "h2").
+ *	@param type : Pointer to location to store the estimator.
+ *	@return int : 0 if success, 1 if the name is not recognised
+ */
+int
+parseRAOEstimatorType(const char * const name, RAOEstimatorType * const type);
+
+/**
+ *	@brief Estimate the noise floor of a power spectrum as the median of its bins between 0 Hz
+ *	(exclusive) and the Nyquist frequency.
+ *
+ *	@param noiseFloor : Pointer to location to store the noise floor.
+ *	@param spectrum   : Pointer to buffer containing the power spectrum.
+ *	@param N          : Number of elements in the spectrum buffer (the FFT size).
+ *	@return int       : 0 if success, 1 if error encountered
+ */
+int
+estimateNoiseFloor(float * const noiseFloor, const float * const spectrum, const size_t N);
+
+/**
+ *	@brief Choose the Tikhonov regularisation of the RAO inversion from the heave noise floor.
+ *	@note In the Wiener filter RAO / (RAO^2 + noise / wave), the unknown wave spectrum is
+ *	replaced by its mean level: the heave power above the noise floor divided by the RAO,
+ *	summed over bins where the RAO is finite and positive.
+ *
+ *	@param heaveSpectrum : Pointer to buffer containing measured heave energy spectrum.
+ *	@param RAO           : Pointer to buffer containing RAO vs frequency for the target vessel.
+ *	@param N             : Number of elements in each buffer array.
+ *	@param noiseFloor    : Noise floor of the heave spectrum.
+ *	@return float        : Regularisation (INFINITY if no bin rises above the noise floor)
+ */
+float
+chooseRegularisation(
+	const float * const heaveSpectrum,
+	const float * const RAO,
+	const size_t        N,
+	const float         noiseFloor);
+
+/**
+ *	@brief Calculate wave energy spectrum from heave energy spectrum and RAO, regularising the
+ *	division where the RAO is small.
+ *	@note Tikhonov deconvolution computes heave * RAO / (RAO^2 + regularisation). Floor
+ *	deconvolution divides by max(RAO, sqrt(regularisation)), the RAO where the Tikhonov gain
+ *	peaks. Either costs one pass over the bins, like calculateWaveEnergySpectrum().
+ *
+ *	@param waveSpectrum   : Pointer to buffer to store wave spectrum.
+ *	@param heaveSpectrum  : Pointer to buffer containing measured heave energy spectrum.
+ *	@param RAO            : Pointer to buffer containing RAO vs frequency for the target vessel.
+ *	@param N              : Number of elements in each buffer array.
+ *	@param settings       : Pointer to deconvolution settings.
+ *	@param regularisation : Pointer to location to store the regularisation used (may be NULL).
+ *	@return int           : 0 if success, 1 if error encountered
+ */
+int
+calculateRegularisedWaveEnergySpectrum(
+	float * const                       waveSpectrum,
+	const float * const                 heaveSpectrum,
+	const float * const                 RAO,
+	const size_t                        N,
+	const DeconvolutionSettings * const settings,
+	float * const                       regularisation);
+
+/**
+ *	@brief Parse the name of a deconvolution scheme.
+ *
+ *	@param name : Scheme name ("exact", "floor" or "tikhonov").
+ *	@param type : Pointer to location to store the scheme.
+ *	@return int : 0 if success, 1 if the name is not recognised
+ */
+int
+parseDeconvolutionType(const char * const name, DeconvolutionType * const type);
@@ -0,0 +1,164 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#include "waveStatistics.h"
+#include <float.h>
+#include <math.h>
+
+void
+waveStatisticsInitialise(
+	WaveStatisticsAccumulator * const accumulator,
+	const double                      frequencyStep,
+	const double                      densityScale)
+{
+	accumulator->frequencyStep = frequencyStep;
+	accumulator->densityScale = densityScale;
+	for (size_t lane = 0; lane < kWaveStatisticsLaneCount; lane++)
+	{
+		accumulator->mMinus1[lane] = 0;
+		accumulator->m0[lane] = 0;
+		accumulator->m1[lane] = 0;
+		accumulator->m2[lane] = 0;
+		accumulator->m4[lane] = 0;
+	}
+	accumulator->peakValue = 0;
+	accumulator->peakBin = 0;
+}
+
+/**
+ *	@brief Add one bin to one lane of the partial sums.
+ */
+static inline void
+accumulateBin(
+	WaveStatisticsAccumulator * const accumulator,
+	const size_t                      lane,
+	const size_t                      bin,
+	const float                       value)
+{
+	/*
+	 *	Infinite and NaN bins compare false and are added as zero.
+	 */
+	const double density = value <= FLT_MAX ? value : 0;
+	const double f = bin * accumulator->frequencyStep;
+	const double fSquared = f * f;
+
+	accumulator->mMinus1[lane] += density / f;
+	accumulator->m0[lane] += density;
+	accumulator->m1[lane] += density * f;
+	accumulator->m2[lane] += density * fSquared;
+	accumulator->m4[lane] += density * fSquared * fSquared;
+}
+
+void
+waveStatisticsAccumulate(
+	WaveStatisticsAccumulator * const accumulator,
+	const float * const               spectrum,
+	const size_t                      firstBin,
+	const size_t                      count)
+{
+	size_t i = 0;
+
+	/*
+	 *	Skip the 0 Hz bin, where f^-1 is not defined (the heave record is detrended).
+	 */
+	if (firstBin == 0 && count > 0)
+	{
+		i = 1;
+	}
+
+	for (; i + kWaveStatisticsLaneCount <= count; i += kWaveStatisticsLaneCount)
+	{
+		for (size_t lane = 0; lane < kWaveStatisticsLaneCount; lane++)
+		{
+			accumulateBin(accumulator, lane, firstBin + i + lane, spectrum[i + lane]);
+		}
+	}
+
+	for (; i < count; i++)
+	{
+		accumulateBin(accumulator, 0, firstBin + i, spectrum[i]);
+	}
+
+	/*
+	 *	The peak search is a separate pass so that it does not hold back the moment sums.
+	 */
+	for (i = firstBin == 0 ? 1 : 0; i < count; i++)
+	{
+		if (spectrum[i] <= FLT_MAX && spectrum[i] > accumulator->peakValue)
+		{
+			accumulator->peakValue = spectrum[i];
+			accumulator->peakBin = firstBin + i;
+		}
+	}
+}
+
+void
+waveStatisticsFinish(
+	const WaveStatisticsAccumulator * const accumulator,
+	WaveStatistics * const                  statistics)
+{
+	const double            scale = accumulator->densityScale * accumulator->frequencyStep;
+	SpectralMoments * const moments = &statistics->moments;
+	SpectralMoments         sums = {0};
+
+	for (size_t lane = 0; lane < kWaveStatisticsLaneCount; lane++)
+	{
+		sums.mMinus1 += accumulator->mMinus1[lane];
+		sums.m0 += accumulator->m0[lane];
+		sums.m1 += accumulator->m1[lane];
+		sums.m2 += accumulator->m2[lane];
+		sums.m4 += accumulator->m4[lane];
+	}
+
+	moments->mMinus1 = scale * sums.mMinus1;
+	moments->m0 = scale * sums.m0;
+	moments->m1 = scale * sums.m1;
+	moments->m2 = scale * sums.m2;
+	moments->m4 = scale * sums.m4;
+
+	statistics->significantWaveHeight = 4 * sqrt(moments->m0);
+	statistics->peakPeriod = accumulator->peakBin > 0
+					 ? 1 / (accumulator->peakBin * accumulator->frequencyStep)
+					 : NAN;
+	statistics->meanPeriod = moments->m0 / moments->m1;
+	statistics->zeroCrossingPeriod = sqrt(moments->m0 / moments->m2);
+	statistics->energyPeriod = moments->mMinus1 / moments->m0;
+	statistics->spectralBandwidth =
+		sqrt(fmax(1 - moments->m2 * moments->m2 / (moments->m0 * moments->m4), 0));
+}
+
+void
+calculateWaveStatistics(
+	WaveStatistics * const statistics,
+	const float * const    spectrum,
+	const size_t           binCount,
+	const double           frequencyStep,
+	const double           densityScale)
+{
+	WaveStatisticsAccumulator accumulator;
+
+	waveStatisticsInitialise(&accumulator, frequencyStep, densityScale);
+	waveStatisticsAccumulate(&accumulator, spectrum, 0, binCount);
+	waveStatisticsFinish(&accumulator, statistics);
+}
@@ -0,0 +1,158 @@
+/*
+ *	Authored 2026, agent.
+ *
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	Permission is hereby granted, free of charge, to any person obtaining a copy
+ *	of this software and associated documentation files (the "Software"), to deal
+ *	in the Software without restriction, including without limitation the rights
+ *	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *	copies of the Software, and to permit persons to whom the Software is
+ *	furnished to do so, subject to the following conditions:
+ *
+ *	The above copyright notice and this permission notice shall be included in all
+ *	copies or substantial portions of the Software.
+ *
+ *	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *	SOFTWARE.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+typedef enum
+{
+	kWaveStatisticsLaneCount = 4,
+} WaveStatisticsConstants;
+
+/**
+ *	@brief Spectral moments m_n = integral of f^n S(f) df, with f in Hz.
+ *
+ */
+typedef struct SpectralMoments
+{
+	double mMinus1;
+	double m0;
+	double m1;
+	double m2;
+	double m4;
+} SpectralMoments;
+
+/**
+ *	@brief Integrated sea state parameters of a wave energy spectrum.
+ *
+ */
+typedef struct WaveStatistics
+{
+	SpectralMoments moments;
+	/*
+	 *	Hs = 4 sqrt(m0)
+	 */
+	float significantWaveHeight;
+	/*
+	 *	Tp = 1 / frequency of the spectral peak
+	 */
+	float peakPeriod;
+	/*
+	 *	Tm01 = m0 / m1
+	 */
+	float meanPeriod;
+	/*
+	 *	Tz = Tm02 = sqrt(m0 / m2)
+	 */
+	float zeroCrossingPeriod;
+	/*
+	 *	Te = Tm-10 = m-1 / m0
+	 */
+	float energyPeriod;
+	/*
+	 *	Cartwright and Longuet-Higgins bandwidth sqrt(1 - m2^2 / (m0 m4))
+	 */
+	float spectralBandwidth;
+} WaveStatistics;
+
+/**
+ *	@brief Running sums of the spectral moments over the bins accumulated so far.
+ *	@note Each moment is summed in kWaveStatisticsLaneCount interleaved partial sums, so the
+ *	pass over the spectrum vectorises without reassociating floating point additions.
+ *
+ */
+typedef struct WaveStatisticsAccumulator
+{
+	double frequencyStep;
+	double densityScale;
+	double mMinus1[kWaveStatisticsLaneCount];
+	double m0[kWaveStatisticsLaneCount];
+	double m1[kWaveStatisticsLaneCount];
+	double m2[kWaveStatisticsLaneCount];
+	double m4[kWaveStatisticsLaneCount];
+	float  peakValue;
+	size_t peakBin;
+} WaveStatisticsAccumulator;
+
+/**
+ *	@brief Start accumulating the statistics of a spectrum.
+ *
+ *	@param accumulator   : Pointer to accumulator to initialise.
+ *	@param frequencyStep : Frequency resolution of the spectrum in Hz.
+ *	@param densityScale  : Factor converting the spectrum bins to a one-sided spectral density
+ *	(e.g., 2 dt / (N window power) for squared FFT magnitudes of N windowed samples).
+ */
+void
+waveStatisticsInitialise(
+	WaveStatisticsAccumulator * const accumulator,
+	const double                      frequencyStep,
+	const double                      densityScale);
+
+/**
+ *	@brief Add consecutive bins of a spectrum to the statistics.
+ *	@note Bins can be added in any number of calls, e.g., as each block of a spectrum is
+ *	produced. The 0 Hz bin, and bins that are not finite (e.g., where the RAO is zero), are
+ *	skipped.
+ *
+ *	@param accumulator : Pointer to accumulator.
+ *	@param spectrum    : Pointer to the bins to add.
+ *	@param firstBin    : Index of spectrum[0] in the whole spectrum.
+ *	@param count       : Number of bins to add.
+ */
+void
+waveStatisticsAccumulate(
+	WaveStatisticsAccumulator * const accumulator,
+	const float * const               spectrum,
+	const size_t                      firstBin,
+	const size_t                      count);
+
+/**
+ *	@brief Derive the sea state parameters from the bins accumulated so far.
+ *	@note The accumulator is not modified, so more bins can be added afterwards.
+ *
+ *	@param accumulator : Pointer to accumulator.
+ *	@param statistics  : Pointer to WaveStatistics to store the parameters.
+ */
+void
+waveStatisticsFinish(
+	const WaveStatisticsAccumulator * const accumulator,
+	WaveStatistics * const                  statistics);
+
+/**
+ *	@brief Calculate the sea state parameters of a whole spectrum.
+ *
+ *	@param statistics    : Pointer to WaveStatistics to store the parameters.
+ *	@param spectrum      : Pointer to buffer containing the spectrum from 0 Hz.
+ *	@param binCount      : Number of bins (e.g., up to but excluding the Nyquist frequency).
+ *	@param frequencyStep : Frequency resolution of the spectrum in Hz.
+ *	@param densityScale  : Factor converting the spectrum bins to a one-sided spectral density.
+ */
+void
+calculateWaveStatistics(
+	WaveStatistics * const statistics,
+	const float * const    spectrum,
+	const size_t           binCount,
+	const double           frequencyStep,
+	const double           densityScale);